@@ -120,7 +120,7 @@ namespace LinkuraLocal::HookMain {
             UnityResolveProgress::classProgress.current = 0;
         }
 
-        Local::LoadData();
+        Local::StartLoadData();
 //        MasterLocal::LoadData();
 
         UnityResolveProgress::startInit = false;
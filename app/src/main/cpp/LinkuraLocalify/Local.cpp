@@ -14,37 +14,57 @@
 #include <string>
 #include <cctype>
 #include <algorithm>
+#include <optional>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <span>
 #include <re2/re2.h>
+#include <re2/set.h>
 #include "BaseDefine.h"
 #include "string_parser/StringParser.hpp"
+#include "string_parser/TextTokenizer.hpp"
+#include "local/CompiledDict.hpp"
+#include "local/StringHash.hpp"
+#include "local/Parallel.hpp"
+#include "local/MissCache.hpp"
+#include "local/ShapeCache.hpp"
+#include "local/TextDump.hpp"
+#include "local/TextClassifier.hpp"
+#include "local/FlatStringMap.hpp"
+#include "local/TranslationTemplate.hpp"
+#include "local/ReaderEpoch.hpp"
+#include "utf/Utf.hpp"
+#include "MasterLocal.h"
 
 // #include "cpprest/details/http_helpers.h"
 
 
 namespace LinkuraLocal::Local {
-    std::unordered_map<std::string, std::string> i18nData{};
-    std::unordered_map<std::string, std::string> i18nDumpData{};
-    std::unordered_map<std::string, std::string> genericText{};
-    std::unordered_map<std::string, std::string> masterText{};
-    std::unordered_map<std::string, std::string> genericSplitText{};
-    std::unordered_map<std::string, std::string> genericFmtText{};
-    std::vector<std::string> genericTextDumpData{};
-    std::vector<std::string> genericSplittedDumpData{};
-    std::vector<std::string> genericOrigTextDumpData{};
-    std::vector<std::string> genericFmtTextDumpData{};
+    TextMap i18nData{};
+    TextMap genericText{};
+    TextMap masterText{};
+    TextMap genericSplitText{};
+    TextMap genericFmtText{};
 
     // 正则表达式匹配存储结构
     struct RegexTranslationItem {
         std::unique_ptr<re2::RE2> regex;
         std::string translation;
+        // translation 预先拆分出的占位符片段
+        TranslationTemplate translationTemplate;
         std::string originalPattern;
+        int captureGroups = 0;
         // for debug output temp
         std::string originalKey;
         std::string originalValue;
 
         RegexTranslationItem(const std::string& pattern, const std::string& trans, const std::string& key, const std::string& value)
-            : translation(trans), originalPattern(pattern), originalKey(key), originalValue(value) {
+            : translation(trans), translationTemplate(trans), originalPattern(pattern), originalKey(key), originalValue(value) {
             regex = std::make_unique<re2::RE2>(pattern);
+            if (regex->ok()) {
+                captureGroups = regex->NumberOfCapturingGroups();
+            }
         }
 
         // 禁用拷贝构造和赋值
@@ -58,7 +78,37 @@ namespace LinkuraLocal::Local {
 
     std::vector<RegexTranslationItem> regexText{};
 
-    std::unordered_set<std::string> translatedText{};
+    // generic 文件中的译文，编译进词典的 Translated 表
+    FlatStringSet genericTranslatedText{};
+    // rules/data 格式的 masterTrans 文件路径，记录到词典中供下次启动时直接交给 MasterLocal
+    std::vector<std::string> masterTableFiles{};
+
+    // 运行时查询用到的全部数据。加载线程构建完成后整体发布，发布后不再修改，
+    // 上面的 map / vector 只在加载线程内作为中间数据使用
+    struct TranslationSnapshot {
+        // generic/master/split/fmt 查询都走编译后的词典
+        std::unique_ptr<CompiledDict> dict{};
+        std::vector<RegexTranslationItem> regexText{};
+        // 所有正则模板合并编译成一个 RE2::Set，一次扫描得到命中的模板下标，再只对命中的模板提取捕获组
+        std::unique_ptr<re2::RE2::Set> regexSet{};
+        // RE2::Set 内部下标 -> regexText 下标
+        std::vector<size_t> regexSetItemIndex{};
+        // RE2::Set 匹配失败（DFA 内存不足）后不会自行恢复，之后本快照直接逐个匹配，警告也只输出一次
+        mutable std::atomic<bool> regexSetFailed{false};
+        // regexText 中第一个模板字面部分含有 FLAG 字符的下标，没有时等于 regexText.size()。
+        // 在它之前命中的正则只取决于文本形状，可以写入 shapeCache
+        size_t firstFlagLiteralRegex = 0;
+        std::unique_ptr<ShapeCache> shapeCache = std::make_unique<ShapeCache>(4096);
+        uint64_t sourceHash = 0;
+        uint64_t generation = 0;
+    };
+
+    // 钩子线程在 snapshotReaders 的读区间内做一次 acquire load，不加锁。
+    // 被替换的快照等读区间内的读者全部离开后才释放，见 PublishSnapshot
+    std::atomic<const TranslationSnapshot*> currentSnapshot{nullptr};
+    ReaderEpoch snapshotReaders{};
+    // 与 currentSnapshot->generation 相同，单独保存以便不进入读区间就能读取
+    std::atomic<uint64_t> currentGeneration{0};
     int genericDumpFileIndex = 0;
     const std::string splitTextPrefix = "[__split__]";
 
@@ -267,8 +317,11 @@ namespace LinkuraLocal::Local {
         return segments;
     }
 
+    // 按写入顺序记录的 key/value，合并到 map 时后写入的覆盖先写入的
+    using TextEntries = std::vector<std::pair<std::string, std::string>>;
+
     // 处理 BeginnerMissionsHint.json 的特殊分割逻辑
-    void ProcessBeginnerMissionsHint(std::unordered_map<std::string, std::string>& dict, const std::string& key, const std::string& value) {
+    void ProcessBeginnerMissionsHint(TextEntries& dict, const std::string& key, const std::string& value) {
 //        Log::InfoFmt("ProcessBeginnerMissionsHint called with key: [%s]", key.c_str());
 //        Log::InfoFmt("ProcessBeginnerMissionsHint called with value: [%s]", value.c_str());
 
@@ -318,7 +371,7 @@ namespace LinkuraLocal::Local {
 
                 if (!keySegment.empty() && !valueSegment.empty()) {
                     // 将分割后的段落对应存入字典
-                    dict[keySegment] = valueSegment;
+                    dict.emplace_back(keySegment, valueSegment);
 //                    Log::InfoFmt("BeginnerMissionsHint split segment %zu: [%s] -> [%s]", i, keySegment.c_str(), valueSegment.c_str());
                 } else {
 //                    Log::WarnFmt("Skipping empty segment %zu (key empty: %s, value empty: %s)", i, keySegment.empty() ? "YES" : "NO", valueSegment.empty() ? "YES" : "NO");
@@ -332,24 +385,17 @@ namespace LinkuraLocal::Local {
     }
 
 
-    std::string findInMapIgnoreSpace(const std::string& key, const std::unordered_map<std::string, std::string>& searchMap) {
-        auto is_space = [](char ch) { return std::isspace(ch); };
-        auto front = std::ranges::find_if_not(key, is_space);
-        auto back = std::ranges::find_if_not(key | std::views::reverse, is_space).base();
-
-        std::string prefix(key.begin(), front);
-        std::string suffix(back, key.end());
+    bool FindDictText(const TranslationSnapshot& snapshot, DictTable table, std::string_view key, std::string_view* ret) {
+        return snapshot.dict && snapshot.dict->Find(table, key, ret);
+    }
 
-        std::string trimmedKey = trim(key);
-        if ( auto it = searchMap.find(trimmedKey); it != searchMap.end()) {
-            return prefix + it->second + suffix;
-        }
-        else {
-            return "";
-        }
+    bool IsTranslatedText(const TranslationSnapshot& snapshot, std::string_view text) {
+        if (snapshot.dict && snapshot.dict->Contains(DictTable::Translated, text)) return true;
+        // MasterLocal 按需加载的表中的译文
+        return MasterLocal::IsTranslatedText(text);
     }
 
-    void ReplaceDollarWithColorTag(std::unordered_map<std::string, std::string>& dict, const std::string& key, const std::string& value, const std::string& color) {
+    void ReplaceDollarWithColorTag(TextEntries& dict, const std::string& key, const std::string& value, const std::string& color) {
         if (key.find('$') == std::string::npos || value.find('$') == std::string::npos) {
             return;
         }
@@ -357,7 +403,7 @@ namespace LinkuraLocal::Local {
         std::string modifiedValue = value;
         modifiedKey.erase(std::remove(modifiedKey.begin(), modifiedKey.end(), '$'), modifiedKey.end());
         modifiedValue.erase(std::remove(modifiedValue.begin(), modifiedValue.end(), '$'), modifiedValue.end());
-        dict[modifiedKey] = modifiedValue;
+        dict.emplace_back(modifiedKey, modifiedValue);
         std::string coloredKey = key;
         std::string coloredValue = value;
         std::string color_tag = "<color=";
@@ -375,7 +421,7 @@ namespace LinkuraLocal::Local {
             coloredValue.replace(pos, 1, (count % 2 == 0) ? color_tag : "</color>");
             pos += (count % 2 == 0) ? 15 : 8; // 跳过替换后的字符串长度
         }
-        dict[coloredKey] = coloredValue;
+        dict.emplace_back(coloredKey, coloredValue);
     }
 
     enum class DumpStrStat {
@@ -393,42 +439,128 @@ namespace LinkuraLocal::Local {
         NO_SPLIT_AND_EMPTY
     };
 
-    void LoadJsonDataToMap(const std::filesystem::path& filePath, std::unordered_map<std::string, std::string>& dict,
-                           const bool insertToTranslated = false, const bool needClearDict = true,
-                           const bool needCheckSplitPrefix = false,
-                           std::vector<RegexTranslationItem>* regexDict = nullptr) {
-        if (!exists(filePath)) return;
+    // 单个 JSON 文件的解析结果，可以在工作线程中生成，之后按文件顺序合并
+    struct JsonTextFileData {
+        bool exists = false;
+        TextEntries entries{};
+        TextEntries splitEntries{};
+        std::vector<std::string> translated{};
+        std::vector<RegexTranslationItem> regexItems{};
+        // rules/data 格式的 masterTrans 文件，不在这里解析，交给 MasterLocal 按需加载
+        bool isMasterTable = false;
+    };
+
+    // 流式读取 {"key": "value"} 格式的文件，键值直接移入 entries，不构造 json 对象。
+    // 值不是字符串或嵌套了对象、数组时停止读取并记录错误
+    class TextEntriesReader : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        TextEntries entries{};
+        std::string error{};
+
+        bool null() override { return Unsupported("null"); }
+        bool boolean(bool) override { return Unsupported("boolean"); }
+        bool number_integer(number_integer_t) override { return Unsupported("number"); }
+        bool number_unsigned(number_unsigned_t) override { return Unsupported("number"); }
+        bool number_float(number_float_t, const string_t&) override { return Unsupported("number"); }
+        bool binary(binary_t&) override { return Unsupported("binary"); }
+
+        bool string(string_t& val) override {
+            if (depth != 1) return Unsupported("string");
+            entries.emplace_back(std::move(currentKey), std::move(val));
+            return true;
+        }
+
+        bool key(string_t& val) override {
+            currentKey = std::move(val);
+            return true;
+        }
+
+        bool start_object(std::size_t) override {
+            return depth++ == 0 || Unsupported("object");
+        }
+
+        bool end_object() override {
+            depth--;
+            return true;
+        }
+
+        bool start_array(std::size_t) override { return Unsupported("array"); }
+        bool end_array() override { return true; }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+            error = ex.what();
+            return false;
+        }
+
+    private:
+        bool Unsupported(const char* type) {
+            error = depth == 0 ? std::string("root is not an object")
+                               : "unsupported " + std::string(type) + " value of key: " + currentKey;
+            return false;
+        }
+
+        std::string currentKey{};
+        int depth = 0;
+    };
+
+    // 与解析成 json 对象后遍历的结果一致：按键排序，同一个键出现多次时保留最后一个
+    void SortTextEntries(TextEntries& entries) {
+        std::ranges::stable_sort(entries, {}, &TextEntries::value_type::first);
+        auto out = entries.begin();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (std::next(it) != entries.end() && std::next(it)->first == it->first) continue;
+            if (out != it) *out = std::move(*it);
+            ++out;
+        }
+        entries.erase(out, entries.end());
+    }
+
+    void ParseJsonTextFile(const std::filesystem::path& filePath, JsonTextFileData& result,
+                           const bool insertToTranslated = false, const bool needCheckSplitPrefix = false,
+                           const bool withRegex = false, const bool acceptMasterTable = false) {
+        // 在 ParallelFor 中调用，不能抛出异常
+        std::error_code ec;
+        if (!std::filesystem::exists(filePath, ec)) return;
+        result.exists = true;
+        if (acceptMasterTable && MasterLocal::IsMasterTableFile(filePath)) {
+            result.isMasterTable = true;
+            return;
+        }
         try {
-            if (needClearDict) {
-                dict.clear();
-            }
-            std::ifstream file(filePath);
+            std::ifstream file(filePath, std::ios::binary);
             if (!file.is_open()) {
                 Log::ErrorFmt("Load %s failed.\n", filePath.string().c_str());
                 return;
             }
-            std::string fileContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            TextEntriesReader reader;
+            if (!nlohmann::json::sax_parse(file, &reader)) {
+                Log::ErrorFmt("Load %s failed: %s\n", filePath.string().c_str(), reader.error.c_str());
+                return;
+            }
             file.close();
-            auto fileData = nlohmann::json::parse(fileContent);
-            for (auto& i : fileData.items()) {
-                std::string key = i.key();
-                std::string value = i.value();
+            auto rawEntries = std::move(reader.entries);
+            SortTextEntries(rawEntries);
+
+            auto& dict = result.entries;
+            dict.reserve(rawEntries.size());
+            const auto filename = filePath.filename().string();
+            for (auto& [key, value] : rawEntries) {
                 if (needCheckSplitPrefix && key.starts_with(splitTextPrefix) && value.starts_with(splitTextPrefix)) {
                     static const auto splitTextPrefixLength = splitTextPrefix.size();
                     const auto splitValue = value.substr(splitTextPrefixLength);
-                    genericSplitText[key.substr(splitTextPrefixLength)] = splitValue;
-                    if (insertToTranslated) translatedText.emplace(splitValue);
+                    result.splitEntries.emplace_back(key.substr(splitTextPrefixLength), splitValue);
+                    if (insertToTranslated) result.translated.emplace_back(splitValue);
                 }
                 else {
                     // 检查是否包含占位符，如果包含则生成正则表达式
-                    if (regexDict != nullptr && key.find('{') != std::string::npos) {
+                    if (withRegex && key.find('{') != std::string::npos) {
                         std::string regexPattern = ConvertToRegexPattern(key);
                         if (!regexPattern.empty()) {
                             try {
-                                regexDict->emplace_back(regexPattern, value, key, value);
-                                if (!regexDict->back().regex->ok()) {
-                                    Log::WarnFmt("Invalid regex pattern: %s (from: %s), error: %s", regexPattern.c_str(), key.c_str(), regexDict->back().regex->error().c_str());
-                                    regexDict->pop_back();
+                                result.regexItems.emplace_back(regexPattern, value, key, value);
+                                if (!result.regexItems.back().regex->ok()) {
+                                    Log::WarnFmt("Invalid regex pattern: %s (from: %s), error: %s", regexPattern.c_str(), key.c_str(), result.regexItems.back().regex->error().c_str());
+                                    result.regexItems.pop_back();
                                 } else {
 //                                    Log::VerboseFmt("Successfully created regex pattern: %s (from: %s)", regexPattern.c_str(), key.c_str());
                                 }
@@ -438,8 +570,7 @@ namespace LinkuraLocal::Local {
                         }
                     }
 
-                    dict[key] = value;
-                    auto filename = filePath.filename().string();
+                    dict.emplace_back(key, value);
 
                     // 特殊处理 BeginnerMissionsHint.json 的 [@数字] 分割
                     if (filename.ends_with("BeginnerMissionsHint.json")) {
@@ -457,7 +588,7 @@ namespace LinkuraLocal::Local {
                         ReplaceDollarWithColorTag(dict, key, value, "#FFFFFF");
                         ReplaceDollarWithColorTag(dict, key, value, "#FD5B91");
                     }
-                    if (insertToTranslated) translatedText.emplace(value);
+                    if (insertToTranslated) result.translated.emplace_back(value);
                 }
             }
         }
@@ -466,69 +597,34 @@ namespace LinkuraLocal::Local {
         }
     }
 
-    void DumpMapDataToJson(const std::filesystem::path& dumpBasePath, const std::filesystem::path& fileName,
-                           const std::unordered_map<std::string, std::string>& dict) {
-        const auto dumpFilePath = dumpBasePath / fileName;
-        try {
-            if (!is_directory(dumpBasePath)) {
-                std::filesystem::create_directories(dumpBasePath);
-            }
-            if (!std::filesystem::exists(dumpFilePath)) {
-                std::ofstream dumpWriteLrcFile(dumpFilePath, std::ofstream::out);
-                dumpWriteLrcFile << "{}";
-                dumpWriteLrcFile.close();
-            }
-
-            std::ifstream dumpLrcFile(dumpFilePath);
-            std::string fileContent((std::istreambuf_iterator<char>(dumpLrcFile)), std::istreambuf_iterator<char>());
-            dumpLrcFile.close();
-            auto fileData = nlohmann::ordered_json::parse(fileContent);
-            for (const auto& i : dict) {
-                fileData[i.first] = i.second;
-            }
-            const auto newStr = fileData.dump(4, 32, false);
-            std::ofstream dumpWriteLrcFile(dumpFilePath, std::ofstream::out);
-            dumpWriteLrcFile << newStr.c_str();
-            dumpWriteLrcFile.close();
+    void MergeJsonTextFileData(JsonTextFileData& data, TextMap& dict,
+                               const bool needClearDict = true, std::vector<RegexTranslationItem>* regexDict = nullptr) {
+        if (!data.exists) return;
+        if (needClearDict) {
+            dict.Clear();
         }
-        catch (std::exception& e) {
-            Log::ErrorFmt("DumpMapDataToJson %s failed: %s", dumpFilePath.c_str(), e.what());
+        for (const auto& [key, value] : data.entries) {
+            dict.AssignText(key, value);
         }
-    }
-
-    void DumpVectorDataToJson(const std::filesystem::path& dumpBasePath, const std::filesystem::path& fileName,
-                           const std::vector<std::string>& vec, const std::string& prefix = "") {
-        const auto dumpFilePath = dumpBasePath / fileName;
-        try {
-            if (!is_directory(dumpBasePath)) {
-                std::filesystem::create_directories(dumpBasePath);
-            }
-            if (!std::filesystem::exists(dumpFilePath)) {
-                std::ofstream dumpWriteLrcFile(dumpFilePath, std::ofstream::out);
-                dumpWriteLrcFile << "{}";
-                dumpWriteLrcFile.close();
-            }
-
-            std::ifstream dumpLrcFile(dumpFilePath);
-            std::string fileContent((std::istreambuf_iterator<char>(dumpLrcFile)), std::istreambuf_iterator<char>());
-            dumpLrcFile.close();
-            auto fileData = nlohmann::ordered_json::parse(fileContent);
-            for (const auto& i : vec) {
-                if (!prefix.empty()) {
-                    fileData[prefix + i] = prefix + i;
-                }
-                else {
-                    fileData[i] = i;
-                }
-            }
-            const auto newStr = fileData.dump(4, 32, false);
-            std::ofstream dumpWriteLrcFile(dumpFilePath, std::ofstream::out);
-            dumpWriteLrcFile << newStr.c_str();
-            dumpWriteLrcFile.close();
+        for (const auto& [key, value] : data.splitEntries) {
+            genericSplitText.AssignText(key, value);
         }
-        catch (std::exception& e) {
-            Log::ErrorFmt("DumpVectorDataToJson %s failed: %s", dumpFilePath.c_str(), e.what());
+        for (const auto& i : data.translated) {
+            genericTranslatedText.Insert(i);
         }
+        if (regexDict) {
+            std::move(data.regexItems.begin(), data.regexItems.end(), std::back_inserter(*regexDict));
+        }
+        data = JsonTextFileData{};
+    }
+
+    void LoadJsonDataToMap(const std::filesystem::path& filePath, TextMap& dict,
+                           const bool insertToTranslated = false, const bool needClearDict = true,
+                           const bool needCheckSplitPrefix = false,
+                           std::vector<RegexTranslationItem>* regexDict = nullptr) {
+        JsonTextFileData data;
+        ParseJsonTextFile(filePath, data, insertToTranslated, needCheckSplitPrefix, regexDict != nullptr);
+        MergeJsonTextFileData(data, dict, needClearDict, regexDict);
     }
 
     std::string to_lower(const std::string& str) {
@@ -537,7 +633,7 @@ namespace LinkuraLocal::Local {
         return lower_str;
     }
 
-    bool IsPureStringValue(const std::string& str) {
+    bool IsPureStringValue(std::string_view str) {
         static std::unordered_set<char> notDeeds = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ':',
                                                     '/', ' ', '.', '%', ',', '+', '-', 'x', '\n'};
         for (const auto& i : str) {
@@ -548,48 +644,72 @@ namespace LinkuraLocal::Local {
         return true;
     }
 
-    std::vector<std::string> SplitByTags(const std::string& origText) {
-        static const std::regex tagsRe("<.*?>(.*?)</.*?>");
-        std::string text = origText;
-        std::smatch match;
-
-        std::vector<std::string> ret{};
-
-        std::string lastSuffix;
-        while (std::regex_search(text, match, tagsRe)) {
-            const auto tagValue = match[1].str();
-            if (IsPureStringValue(tagValue)) {
-                ret.push_back(match.prefix().str());
-                lastSuffix = match.suffix().str();
+    // 按 "<tag>值</tag>" 拆分文本：值为纯数字等时，取出各个这样的标签对之间的文本
+    std::vector<std::string_view> SplitByTags(std::string_view text) {
+        constexpr auto npos = std::string_view::npos;
+        std::vector<std::string_view> ret{};
+
+        std::string_view lastSuffix;
+        size_t searchStart = 0;  // 上一对标签结束的位置
+        size_t openBegin = npos;
+        size_t valueBegin = 0;
+        StringParser::TextTokenizer tokenizer(text, StringParser::kSplitFlags);
+        for (StringParser::Token token; tokenizer.Next(&token);) {
+            // 标签和值都不跨行，跨行的“标签”从换行之后重新查找
+            if (const auto newline = token.text.find('\n'); newline != npos) {
+                openBegin = npos;
+                if (token.type == StringParser::TokenType::Tag) {
+                    tokenizer.Seek(token.offset + newline + 1);
+                }
+                continue;
+            }
+            if (token.type != StringParser::TokenType::Tag || !token.text.starts_with('<') || !token.text.ends_with('>')) {
+                continue;
+            }
+            if (openBegin != npos && token.text.starts_with("</")) {
+                const auto tagEnd = token.offset + token.text.size();
+                if (IsPureStringValue(text.substr(valueBegin, token.offset - valueBegin))) {
+                    ret.emplace_back(text.substr(searchStart, openBegin - searchStart));
+                    lastSuffix = text.substr(tagEnd);
+                }
+                searchStart = tagEnd;
+                openBegin = npos;
+                continue;
+            }
+            // 值中间的其它标签算作值的一部分
+            if (openBegin == npos) {
+                openBegin = token.offset;
+                valueBegin = token.offset + token.text.size();
             }
-            text = match.suffix().str();
         }
         if (!lastSuffix.empty()) {
-            ret.push_back(lastSuffix);
+            ret.emplace_back(lastSuffix);
         }
-
         return ret;
     }
 
     void ProcessGenericTextLabels() {
-        std::unordered_map<std::string, std::string> appendsText{};
+        // 遍历时不能插入，先收集再追加；已有的 key 不覆盖。收集的片段指向 arena，追加时不会失效
+        std::vector<std::pair<std::string_view, std::string_view>> appendsText{};
 
-        for (const auto& i : genericText) {
-            const auto origContents = SplitByTags(i.first);
+        for (const auto& [key, value] : genericText) {
+            const auto origContents = SplitByTags(key);
             if (origContents.empty()) {
                 continue;
             }
-            const auto translatedContents = SplitByTags(i.second);
+            const auto translatedContents = SplitByTags(value);
             if (origContents.size() == translatedContents.size()) {
                 for (const auto& [orig, trans] : std::ranges::views::zip(origContents, translatedContents)) {
-                    appendsText.emplace(orig, trans);
+                    appendsText.emplace_back(orig, trans);
                 }
             }
         }
-        genericText.insert(appendsText.begin(), appendsText.end());
+        for (const auto& [orig, trans] : appendsText) {
+            genericText.EmplaceText(orig, trans);
+        }
     }
 
-    bool ReplaceString(std::string* str, const std::string& oldSubstr, const std::string& newSubstr) {
+    bool ReplaceString(std::string* str, std::string_view oldSubstr, std::string_view newSubstr) {
         size_t pos = str->find(oldSubstr);
         if (pos != std::string::npos) {
             str->replace(pos, oldSubstr.length(), newSubstr);
@@ -598,27 +718,7 @@ namespace LinkuraLocal::Local {
         return false;
     }
 
-    // 智能替换所有格式化占位符
-    void ReplaceAllPlaceholders(std::string* str, int paramIndex, const std::string& value) {
-        // 使用RE2正则表达式一次性替换所有可能的格式
-        std::string pattern = "\\{" + std::to_string(paramIndex) + "(?::[fF]\\d*)?\\}";
-        RE2 re(pattern);
-        if (re.ok()) {
-            RE2::GlobalReplace(str, re, value);
-        } else {
-            // 如果正则表达式失败，回退到逐一替换
-            std::string basePattern = "{" + std::to_string(paramIndex) + "}";
-            ReplaceString(str, basePattern, value);
-            ReplaceString(str, basePattern.substr(0, basePattern.length()-1) + ":f}", value);
-            ReplaceString(str, basePattern.substr(0, basePattern.length()-1) + ":F}", value);
-            for (int i = 1; i <= 9; ++i) {
-                ReplaceString(str, basePattern.substr(0, basePattern.length()-1) + ":f" + std::to_string(i) + "}", value);
-                ReplaceString(str, basePattern.substr(0, basePattern.length()-1) + ":F" + std::to_string(i) + "}", value);
-            }
-        }
-    }
-
-    bool GetSplitTagsTranslation(const std::string& origText, std::string* newText, std::vector<std::string>& unTransResultRet) {
+    bool GetSplitTagsTranslation(const TranslationSnapshot& snapshot, const std::string& origText, std::string* newText, std::vector<std::string>& unTransResultRet) {
         if (!origText.contains('<')) return false;
         const auto splitResult = SplitByTags(origText);
         if (splitResult.empty()) return false;
@@ -626,8 +726,8 @@ namespace LinkuraLocal::Local {
         *newText = origText;
         bool ret = true;
         for (const auto& i : splitResult) {
-            if (const auto iter = genericText.find(i); iter != genericText.end()) {
-                ReplaceString(newText, i, iter->second);
+            if (std::string_view value; FindDictText(snapshot, DictTable::Generic, i, &value)) {
+                ReplaceString(newText, i, value);
             }
             else {
                 unTransResultRet.emplace_back(i);
@@ -646,128 +746,184 @@ namespace LinkuraLocal::Local {
         }
     }
 
-    SplitTagsTranslationStat GetSplitTagsTranslationFull(const std::string& origTextIn, std::string* newText, std::vector<std::string>& unTransResultRet) {
-        // static const std::u16string splitFlags = u"0123456789+＋-－%％【】.";
-        static const std::unordered_set<char16_t> splitFlags = {u'0', u'1', u'2', u'3', u'4', u'5',
-                                                                u'6', u'7', u'8', u'9', u'+', u'＋',
-                                                                u'-', u'－', u'%', u'％', u'【', u'】',
-                                                                u'.', u':', u'：', u'×'};
-
-        const auto origText = Misc::ToUTF16(origTextIn);
-        bool isInTag = false;
-        std::vector<std::string> waitingReplaceTexts{};
-
-        std::u16string currentWaitingReplaceText;
-
-#ifdef GKMS_WINDOWS
-#define checkCurrentWaitingReplaceTextAndClear() \
-    if (!currentWaitingReplaceText.empty()) { \
-        auto trimmed = trim(Misc::ToUTF8(currentWaitingReplaceText)); \
-        waitingReplaceTexts.push_back(trimmed); \
-        currentWaitingReplaceText.clear(); }
-#else
-#define checkCurrentWaitingReplaceTextAndClear() \
-    if (!currentWaitingReplaceText.empty()) { \
-        waitingReplaceTexts.push_back(Misc::ToUTF8(currentWaitingReplaceText)); \
-        currentWaitingReplaceText.clear(); }
-#endif
-
-        for (char16_t currChar : origText) {
-            if (currChar == u'<') {
-                isInTag = true;
-            }
-            if (currChar == u'>') {
-                isInTag = false;
-                checkCurrentWaitingReplaceTextAndClear()
-                continue;
+    // 标签和 splitFlags 之间的一段文本在原文中的字节范围
+    struct SplitRun {
+        size_t begin;
+        size_t end;
+    };
+
+    SplitTagsTranslationStat GetSplitTagsTranslationFull(const TranslationSnapshot& snapshot, const std::string& origText, std::string* newText, std::vector<std::string>& unTransResultRet) {
+        // 一次扫描 UTF-8 原文找出所有待替换的文本段，段的边界就是标签和 splitFlags，
+        // 每段只需在 Split 表中查一次，不必对全部 key 做多模式匹配
+        thread_local std::vector<SplitRun> runs;
+        runs.clear();
+        StringParser::TextTokenizer tokenizer(origText, StringParser::kSplitFlags);
+        for (StringParser::Token token; tokenizer.Next(&token);) {
+            if (token.type == StringParser::TokenType::Text) {
+                runs.push_back({token.offset, token.offset + token.text.size()});
             }
-            if (isInTag) {
-                checkCurrentWaitingReplaceTextAndClear()
+        }
+        if (runs.empty()) {
+            return SplitTagsTranslationStat::NO_SPLIT_AND_EMPTY;
+        }
+        // 只有末尾一段文本，且开头不是特殊符号或数字
+        if (runs.size() == 1 && runs[0].end == origText.size() && StringParser::kSplitFlags.CharLength(origText, 0) == 0) {
+            return SplitTagsTranslationStat::NO_SPLIT;
+        }
+
+        // 按顺序把原文和译文拼接到输出，只遍历一次
+        newText->clear();
+        newText->reserve(origText.size() * 2);
+        size_t copied = 0;
+        bool hasTrans = false;
+        bool hasNotTrans = false;
+        constexpr auto npos = std::string_view::npos;
+        constexpr std::string_view spaceChars = " \t\n\v\f\r";
+        for (const auto& run : runs) {
+            const std::string_view runText(origText.data() + run.begin, run.end - run.begin);
+            const auto front = runText.find_first_not_of(spaceChars);
+            const auto back = front == npos ? npos : runText.find_last_not_of(spaceChars) + 1;
+            const auto trimmed = front == npos ? std::string_view{} : runText.substr(front, back - front);
+
+            std::string_view value;
+            if (!FindDictText(snapshot, DictTable::Split, trimmed, &value) || (value.empty() && trimmed.size() == runText.size())) {
+                unTransResultRet.emplace_back(trimmed);
+                hasNotTrans = true;
                 continue;
             }
-
-            if (!splitFlags.contains(currChar)) {
-                currentWaitingReplaceText.push_back(currChar);
+            hasTrans = true;
+            newText->append(origText, copied, run.begin - copied);
+            const auto prefix = runText.substr(0, front == npos ? runText.size() : front);
+            const auto suffix = front == npos ? std::string_view{} : runText.substr(back);
+            if (value.find("，") != std::string_view::npos) {
+                std::string replaced;
+                replaced.append(prefix).append(value).append(suffix);
+                ReplaceNumberComma(&replaced);
+                newText->append(replaced);
             }
             else {
-                checkCurrentWaitingReplaceTextAndClear()
+                newText->append(prefix).append(value).append(suffix);
             }
+            copied = run.end;
         }
-        if (waitingReplaceTexts.empty()) {
-            if (currentWaitingReplaceText.empty()) {
-                return SplitTagsTranslationStat::NO_SPLIT_AND_EMPTY;
+        newText->append(origText, copied);
+
+        if (hasTrans && hasNotTrans) {
+            return SplitTagsTranslationStat::PART_TRANS;
+        }
+        if (hasTrans) {
+            return SplitTagsTranslationStat::FULL_TRANS;
+        }
+        return SplitTagsTranslationStat::NO_TRANS;
+    }
+
+    void BuildRegexSet(TranslationSnapshot& snapshot) {
+        auto& regexText = snapshot.regexText;
+        auto& regexSetItemIndex = snapshot.regexSetItemIndex;
+        snapshot.regexSet.reset();
+        regexSetItemIndex.clear();
+        if (regexText.empty()) return;
+
+        re2::RE2::Options options;
+        // 模板数量较多时 DFA 需要更多内存，默认的 8MB 容易在匹配时溢出
+        options.set_max_mem(64 << 20);
+        auto set = std::make_unique<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+        regexSetItemIndex.reserve(regexText.size());
+
+        for (size_t i = 0; i < regexText.size(); i++) {
+            std::string error;
+            if (set->Add(regexText[i].originalPattern, &error) < 0) {
+                Log::WarnFmt("RE2::Set add pattern failed: %s, error: %s", regexText[i].originalPattern.c_str(), error.c_str());
+                continue;
             }
-            else {
-                if (!(!origText.empty() && splitFlags.contains(origText[0]))) {  // 开头为特殊符号或数字
-                    return SplitTagsTranslationStat::NO_SPLIT;
+            regexSetItemIndex.push_back(i);
+        }
+        if (!set->Compile()) {
+            Log::ErrorFmt("RE2::Set compile failed, fallback to linear regex matching.");
+            regexSetItemIndex.clear();
+            return;
+        }
+        snapshot.regexSet = std::move(set);
+    }
+
+    size_t FindFirstFlagLiteralRegex(const std::vector<RegexTranslationItem>& items) {
+        for (size_t i = 0; i < items.size(); i++) {
+            const auto& key = items[i].originalKey;
+            // 去掉 {0}、{1:F2} 这类占位符，只检查字面部分
+            std::string literal;
+            for (size_t pos = 0; pos < key.size(); pos++) {
+                if (key[pos] == '{' && pos + 1 < key.size() && std::isdigit(static_cast<unsigned char>(key[pos + 1]))) {
+                    if (const auto close = key.find('}', pos); close != std::string::npos) {
+                        pos = close;
+                        continue;
+                    }
                 }
+                literal.push_back(key[pos]);
             }
+            if (StringParser::ContainsFlagChar(literal)) return i;
         }
-        checkCurrentWaitingReplaceTextAndClear()
+        return items.size();
+    }
 
-        *newText = origTextIn;
-        SplitTagsTranslationStat ret;
-        bool hasTrans = false;
-        bool hasNotTrans = false;
-        if (!waitingReplaceTexts.empty()) {
-            for (const auto& i : waitingReplaceTexts) {
-                std::string searchResult = findInMapIgnoreSpace(i, genericSplitText);
-                if (!searchResult.empty()) {
-                    ReplaceNumberComma(&searchResult);
-                    ReplaceString(newText, i, searchResult);
-                    hasTrans = true;
-                }
-                else {
-                    unTransResultRet.emplace_back(trim(i));
-                    hasNotTrans = true;
+    // 所有翻译源文件的路径、大小和修改时间的哈希，用于判断编译后的词典是否过期
+    uint64_t GetTranslationSourceHash(const std::vector<std::filesystem::path>& sourceFiles, const std::vector<std::filesystem::path>& sourceDirs) {
+        std::vector<std::filesystem::path> files;
+        for (const auto& file : sourceFiles) {
+            if (std::filesystem::is_regular_file(file)) files.push_back(file);
+        }
+        for (const auto& dir : sourceDirs) {
+            if (!std::filesystem::is_directory(dir)) continue;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(dir)) {
+                if (entry.is_regular_file() && to_lower(entry.path().extension().string()) == ".json") {
+                    files.push_back(entry.path());
                 }
             }
-            if (hasTrans && hasNotTrans) {
-                ret = SplitTagsTranslationStat::PART_TRANS;
-            }
-            else if (hasTrans && !hasNotTrans) {
-                ret = SplitTagsTranslationStat::FULL_TRANS;
-            }
-            else {
-                ret = SplitTagsTranslationStat::NO_TRANS;
-            }
         }
-        else {
-            ret = SplitTagsTranslationStat::NO_TRANS;
+        std::sort(files.begin(), files.end());
+
+        uint64_t hash = HashText(Config::localeCode);
+        for (const auto& file : files) {
+            std::error_code ec;
+            const uint64_t fileInfo[2] = {
+                    static_cast<uint64_t>(std::filesystem::file_size(file, ec)),
+                    static_cast<uint64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count())
+            };
+            hash = HashText(file.string()) ^ (hash * 31);
+            hash = HashBytes(fileInfo, sizeof(fileInfo), hash);
         }
-        return ret;
+        return hash;
     }
 
-    void LoadData() {
-        static auto localizationFile = GetBasePath() / "local-files"/ Config::localeCode / "localization.json";
-        static auto genericFile = GetBasePath() / "local-files"/ Config::localeCode / "generic.json";
-        static auto genericSplitFile = GetBasePath() / "local-files"/ Config::localeCode / "generic.split.json";
-        static auto genericDir = GetBasePath() / "local-files"/ Config::localeCode / "genericTrans";
-        static auto masterDir = GetBasePath() / "local-files"/ Config::localeCode / "masterTrans";
-//        if (!std::filesystem::is_regular_file(localizationFile)) {
-//            Log::ErrorFmt("localizationFile: %s not found.", localizationFile.c_str());
-//            return;
-//        }
-//        LoadJsonDataToMap(localizationFile, i18nData, true);
-        Log::InfoFmt("%ld localization items loaded.", i18nData.size());
+    struct JsonLoadTask {
+        std::filesystem::path path;
+        TextMap* dict;
+        bool needClearDict;
+        bool needCheckSplitPrefix;
+        bool withRegex;
+        bool isMaster;
+        JsonTextFileData data{};
+    };
 
-        LoadJsonDataToMap(genericFile, genericText, true, true, true, &regexText);
-        genericSplitText.clear();
-        genericFmtText.clear();
-        LoadJsonDataToMap(genericSplitFile, genericSplitText, true, true, true);
+    // 在工作线程中并行解析所有文件，再按原来的顺序合并，保证覆盖优先级与逐个加载时一致。
+    // 返回 rules/data 格式的 masterTrans 文件路径，这些文件只读取了 rules 头部
+    std::vector<std::filesystem::path> LoadJsonSourceData(const std::filesystem::path& genericFile, const std::filesystem::path& genericSplitFile,
+                                                                   const std::filesystem::path& genericDir, const std::filesystem::path& masterDir) {
+        std::vector<JsonLoadTask> tasks;
+        tasks.push_back({genericFile, &genericText, true, true, true, false});
+        tasks.push_back({genericSplitFile, &genericSplitText, true, true, false, false});
         if (std::filesystem::exists(genericDir) || std::filesystem::is_directory(genericDir)) {
             for (const auto& entry : std::filesystem::recursive_directory_iterator(genericDir)) {
                 if (std::filesystem::is_regular_file(entry.path())) {
                     const auto& currFile = entry.path();
                     if (to_lower(currFile.extension().string()) == ".json") {
                         if (currFile.filename().string().ends_with(".split.json")) {  // split text file
-                            LoadJsonDataToMap(currFile, genericSplitText, true, false, true);
+                            tasks.push_back({currFile, &genericSplitText, false, true, false, false});
                         }
                         if (currFile.filename().string().ends_with(".fmt.json")) {  // fmt text file
-                            LoadJsonDataToMap(currFile, genericFmtText, true, false, false);
+                            tasks.push_back({currFile, &genericFmtText, false, false, false, false});
                         }
                         else {
-                            LoadJsonDataToMap(currFile, genericText, true, false, true, &regexText);
+                            tasks.push_back({currFile, &genericText, false, true, true, false});
                         }
                     }
                 }
@@ -779,46 +935,260 @@ namespace LinkuraLocal::Local {
                 if (std::filesystem::is_regular_file(entry.path())) {
                     const auto& currFile = entry.path();
                     if (to_lower(currFile.extension().string()) == ".json") {
-                        LoadJsonDataToMap(currFile, masterText, true, false, true, &regexText);
+                        tasks.push_back({currFile, &masterText, false, true, true, true});
                     }
                 }
             }
         }
 
+        ParallelFor(tasks.size(), [&tasks](size_t i) {
+            auto& task = tasks[i];
+            ParseJsonTextFile(task.path, task.data, true, task.needCheckSplitPrefix, task.withRegex, task.isMaster);
+        });
+
+        std::vector<std::filesystem::path> masterTables;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            auto& task = tasks[i];
+            if (task.data.isMasterTable) {
+                masterTableFiles.push_back(task.path.string());
+                masterTables.push_back(task.path);
+            }
+            MergeJsonTextFileData(task.data, *task.dict, task.needClearDict, task.withRegex ? &regexText : nullptr);
+            if (i == 0) {
+                // generic.json 加载后清空 split/fmt，与逐个加载时的顺序保持一致
+                genericSplitText.Clear();
+                genericFmtText.Clear();
+            }
+        }
+
         ProcessGenericTextLabels();
-        Log::InfoFmt("%ld generic text items loaded.", genericText.size());
-        Log::InfoFmt("%ld master text items loaded.", masterText.size());
-        Log::InfoFmt("%ld regex patterns loaded.", regexText.size());
+        Log::InfoFmt("%zu translation files parsed.", tasks.size());
+        return masterTables;
+    }
+
+    // 清空加载线程使用的中间数据，热重载时会重新从 JSON 构建
+    void ClearStagingData() {
+        genericText.Clear();
+        masterText.Clear();
+        genericSplitText.Clear();
+        genericFmtText.Clear();
+        genericTranslatedText.Clear();
+        std::vector<std::string>().swap(masterTableFiles);
+        std::vector<RegexTranslationItem>().swap(regexText);
+    }
+
+    // 把 JSON 解析结果编译成词典，写入缓存后再 mmap 回来
+    std::unique_ptr<CompiledDict> CompileLoadedData(const std::filesystem::path& compiledDictFile, uint64_t sourceHash) {
+        CompiledDictBuilder builder;
+        for (const auto& [key, value] : genericText) builder.Add(DictTable::Generic, key, value);
+        for (const auto& [key, value] : masterText) builder.Add(DictTable::Master, key, value);
+        for (const auto& [key, value] : genericSplitText) builder.Add(DictTable::Split, key, value);
+        for (const auto& [key, value] : genericFmtText) builder.Add(DictTable::Fmt, key, value);
+        genericTranslatedText.ForEach([&](std::string_view text) { builder.Add(DictTable::Translated, text); });
+        for (const auto& item : regexText) {
+            builder.Add(DictTable::Regex, item.originalKey, item.translation);
+            builder.Add(DictTable::RegexPattern, item.originalPattern);
+        }
+        for (const auto& file : masterTableFiles) {
+            builder.Add(DictTable::MasterTableFiles, file);
+        }
+        auto image = builder.Build(sourceHash);
+
+        std::unique_ptr<CompiledDict> dict{};
+        if (WriteCompiledDict(compiledDictFile, image)) {
+            dict = CompiledDict::Open(compiledDictFile, sourceHash);
+        }
+        if (!dict) {
+            Log::WarnFmt("Compiled translation dict not cached, using in-memory image.");
+            dict = CompiledDict::FromImage(std::move(image));
+        }
+        if (!dict) {
+            Log::ErrorFmt("Build compiled translation dict failed.");
+        }
+        return dict;
+    }
+
+    void LoadRegexTextFromDict(TranslationSnapshot& snapshot) {
+        const auto& dict = *snapshot.dict;
+        auto& items = snapshot.regexText;
+        const auto count = dict.Size(DictTable::Regex);
+        items.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            const std::string pattern(dict.KeyAt(DictTable::RegexPattern, i));
+            const std::string key(dict.KeyAt(DictTable::Regex, i));
+            const std::string value(dict.ValueAt(DictTable::Regex, i));
+            items.emplace_back(pattern, value, key, value);
+            if (!items.back().regex->ok()) {
+                items.pop_back();
+            }
+        }
+    }
+
+    struct TranslationSources {
+        std::filesystem::path genericFile;
+        std::filesystem::path genericSplitFile;
+        std::filesystem::path genericDir;
+        std::filesystem::path masterDir;
+        std::filesystem::path compiledDictFile;
+
+        [[nodiscard]] uint64_t Hash() const {
+            return GetTranslationSourceHash({genericFile, genericSplitFile}, {genericDir, masterDir});
+        }
+    };
+
+    const TranslationSources& GetTranslationSources() {
+        static const TranslationSources sources = [] {
+            const auto localeDir = GetBasePath() / "local-files" / Config::localeCode;
+            return TranslationSources{
+                    .genericFile = localeDir / "generic.json",
+                    .genericSplitFile = localeDir / "generic.split.json",
+                    .genericDir = localeDir / "genericTrans",
+                    .masterDir = localeDir / "masterTrans",
+                    .compiledDictFile = localeDir / "translation.lkdict",
+            };
+        }();
+        return sources;
+    }
+
+    // 只在加载线程中调用
+    std::unique_ptr<TranslationSnapshot> BuildSnapshot(const TranslationSources& sources, uint64_t sourceHash) {
+        auto snapshot = std::make_unique<TranslationSnapshot>();
+        snapshot->sourceHash = sourceHash;
+
+        std::vector<std::filesystem::path> masterTables;
+        if (auto dict = CompiledDict::Open(sources.compiledDictFile, sourceHash)) {
+            snapshot->dict = std::move(dict);
+            LoadRegexTextFromDict(*snapshot);
+            Log::InfoFmt("Compiled translation dict loaded: %s (%zu bytes)", sources.compiledDictFile.string().c_str(), snapshot->dict->ByteSize());
+
+            for (size_t i = 0; i < snapshot->dict->Size(DictTable::MasterTableFiles); i++) {
+                masterTables.emplace_back(snapshot->dict->KeyAt(DictTable::MasterTableFiles, i));
+            }
+        }
+        else {
+            ClearStagingData();
+            masterTables = LoadJsonSourceData(sources.genericFile, sources.genericSplitFile, sources.genericDir, sources.masterDir);
+            snapshot->dict = CompileLoadedData(sources.compiledDictFile, sourceHash);
+            snapshot->regexText = std::move(regexText);
+            ClearStagingData();
+        }
+        // 只登记表，译文在第一次用到时加载
+        MasterLocal::RegisterTables(masterTables);
+
+        BuildRegexSet(*snapshot);
+        snapshot->firstFlagLiteralRegex = FindFirstFlagLiteralRegex(snapshot->regexText);
+        if (snapshot->dict) {
+            Log::InfoFmt("%ld generic text items loaded.", snapshot->dict->Size(DictTable::Generic));
+            Log::InfoFmt("%ld master text items loaded.", snapshot->dict->Size(DictTable::Master));
+        }
+        Log::InfoFmt("%ld regex patterns loaded, %ld in regex set.", snapshot->regexText.size(), snapshot->regexSetItemIndex.size());
+        return snapshot;
+    }
 
-        static auto dumpBasePath = GetBasePath() / "dump-files";
-        static auto dumpFilePath = dumpBasePath / "localization.json";
-        LoadJsonDataToMap(dumpFilePath, i18nDumpData);
+    constexpr auto kSourceWatchInterval = std::chrono::seconds(3);
+    // 调试模式下每分钟输出一次查询统计
+    constexpr uint64_t kLookupStatsLogTicks = 20;
+
+    // TMP 每帧都会重新设置同样的文本，记住没有译文的文本，跳过后续的 fmt 解析、正则和分割匹配
+    MissCache missCache{4096};
+    // ClassifyText 直接放行的调用数，调试模式下与总调用数一起输出
+    std::atomic<uint64_t> classifiedCalls{0};
+    std::atomic<uint64_t> classifiedSkips{0};
+
+    // 仅加载线程访问
+    uint64_t snapshotGeneration = 0;
+
+    // 等待仍在使用旧快照的钩子调用结束后再释放旧快照。读者被 GC、调试器或切到后台卡住时，
+    // 加载线程会一直等待，不会提前释放
+    void PublishSnapshot(std::unique_ptr<TranslationSnapshot> snapshot) {
+        snapshot->generation = ++snapshotGeneration;
+        const auto generation = snapshot->generation;
+        std::unique_ptr<const TranslationSnapshot> old(currentSnapshot.exchange(snapshot.release(), std::memory_order_acq_rel));
+        currentGeneration.store(generation, std::memory_order_release);
+        if (old) {
+            snapshotReaders.Synchronize();
+        }
+    }
+
+    // 翻译源文件有变化（或尚未加载）时重新构建并发布快照
+    bool ReloadIfChanged() {
+        const auto& sources = GetTranslationSources();
+        const auto sourceHash = sources.Hash();
+        if (const auto current = currentSnapshot.load(std::memory_order_acquire); current && current->sourceHash == sourceHash) {
+            return false;
+        }
+        PublishSnapshot(BuildSnapshot(sources, sourceHash));
+        return true;
+    }
+
+    void LoadData() {
+        static auto localizationFile = GetBasePath() / "local-files"/ Config::localeCode / "localization.json";
+//        if (!std::filesystem::is_regular_file(localizationFile)) {
+//            Log::ErrorFmt("localizationFile: %s not found.", localizationFile.c_str());
+//            return;
+//        }
+//        LoadJsonDataToMap(localizationFile, i18nData, true);
+        Log::InfoFmt("%ld localization items loaded.", i18nData.size());
+
+        try {
+            ReloadIfChanged();
+        }
+        catch (std::exception& e) {
+            Log::ErrorFmt("Load translation data failed: %s", e.what());
+        }
+    }
+
+    uint64_t GetDataGeneration() {
+        return currentGeneration.load(std::memory_order_acquire);
+    }
+
+    void LogLookupStats() {
+        const auto hits = missCache.Hits();
+        const auto misses = missCache.Misses();
+        const auto total = hits + misses;
+        Log::DebugFmt("GetGenericText miss cache: %llu hits, %llu misses (%.1f%% hit rate, capacity %zu)",
+                      static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses),
+                      total == 0 ? 0.0 : hits * 100.0 / total, missCache.Capacity());
+        const auto calls = classifiedCalls.load(std::memory_order_relaxed);
+        const auto skips = classifiedSkips.load(std::memory_order_relaxed);
+        Log::DebugFmt("GetGenericText classifier: %llu of %llu calls skipped (%.1f%%)",
+                      static_cast<unsigned long long>(skips), static_cast<unsigned long long>(calls),
+                      calls == 0 ? 0.0 : skips * 100.0 / calls);
+    }
+
+    void StartLoadData() {
+        std::thread([]() {
+            LoadData();
+            Log::Info("Translation data ready.");
+            // 轮询翻译源文件，修改后无需重启游戏即可生效
+            for (uint64_t tick = 1; ; tick++) {
+                std::this_thread::sleep_for(kSourceWatchInterval);
+                if (Config::dbgMode && tick % kLookupStatsLogTicks == 0) {
+                    LogLookupStats();
+                }
+                try {
+                    if (ReloadIfChanged()) {
+                        Log::Info("Translation data reloaded.");
+                    }
+                }
+                catch (std::exception& e) {
+                    Log::ErrorFmt("Reload translation data failed: %s", e.what());
+                }
+            }
+        }).detach();
     }
 
     bool GetI18n(const std::string& key, std::string* ret) {
-        if (const auto iter = i18nData.find(key); iter != i18nData.end()) {
-            *ret = iter->second;
+        if (const auto value = i18nData.Find(key)) {
+            *ret = *value;
             return true;
         }
         return false;
     }
 
-    bool inDump = false;
     void DumpI18nItem(const std::string& key, const std::string& value) {
         if (!Config::dumpText) return;
-        if (i18nDumpData.contains(key)) return;
-        i18nDumpData[key] = value;
-        Log::DebugFmt("DumpI18nItem: %s - %s", key.c_str(), value.c_str());
-
-        static auto dumpBasePath = GetBasePath() / "dump-files";
-
-        if (inDump) return;
-        inDump = true;
-        std::thread([](){
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-            DumpMapDataToJson(dumpBasePath, "localization.json", i18nDumpData);
-            inDump = false;
-        }).detach();
+        EnqueueTextDump("localization.json", key, value);
     }
 
     std::string readFileToString(const std::string& filename) {
@@ -865,170 +1235,264 @@ namespace LinkuraLocal::Local {
         }
     }
 
-    bool inDumpGeneric = false;
-    void DumpGenericText(const std::string& origText, DumpStrStat stat = DumpStrStat::DEFAULT) {
-        if (translatedText.contains(origText)) return;
-
-        std::array<std::reference_wrapper<std::vector<std::string>>, 4> targets = {
-                genericTextDumpData,
-                genericOrigTextDumpData,
-                genericSplittedDumpData,
-                genericFmtTextDumpData
-        };
+    void DumpGenericText(const TranslationSnapshot& snapshot, const std::string& origText, DumpStrStat stat = DumpStrStat::DEFAULT) {
+        if (IsTranslatedText(snapshot, origText)) return;
+        if (IsPureStringValue(origText)) return;
 
-        auto& appendTarget = targets[static_cast<int>(stat)].get();
+        const auto fileName = GetDumpGenericFileName(stat);
+        if (stat == DumpStrStat::SPLITTED) {
+            const auto text = splitTextPrefix + origText;
+            EnqueueTextDump(fileName, text, text);
+        }
+        else {
+            EnqueueTextDump(fileName, origText, origText);
+        }
+    }
 
-        if (std::find(appendTarget.begin(), appendTarget.end(), origText) != appendTarget.end()) {
-            return;
+    // 提取捕获组用的线程本地缓冲，容量只增不减，稳定后匹配不再分配内存
+    struct RegexCaptureBuffer {
+        // values[i] 为第 i + 1 个捕获组，args[i] 指向 values[i]
+        std::vector<absl::string_view> values{};
+        std::deque<re2::RE2::Arg> args{};
+        std::vector<const re2::RE2::Arg*> argPointers{};
+        // 最近一次命中的捕获组，指向原文
+        std::vector<std::string_view> captures{};
+
+        void Reserve(int groups) {
+            const auto count = static_cast<size_t>(groups);
+            if (args.size() >= count) return;
+            // RE2::Arg 不可移动，扩容时整体重建
+            values.resize(count);
+            args.clear();
+            argPointers.clear();
+            for (auto& value : values) {
+                argPointers.push_back(&args.emplace_back(&value));
+            }
+            captures.reserve(count);
         }
-        if (IsPureStringValue(origText)) return;
+    };
 
-        appendTarget.push_back(origText);
-        static auto dumpBasePath = GetBasePath() / "dump-files";
-
-        if (inDumpGeneric) return;
-        inDumpGeneric = true;
-        std::thread([](){
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-            DumpVectorDataToJson(dumpBasePath, GetDumpGenericFileName(DumpStrStat::DEFAULT), genericTextDumpData);
-            DumpVectorDataToJson(dumpBasePath, GetDumpGenericFileName(DumpStrStat::SPLITTABLE_ORIG), genericOrigTextDumpData);
-            DumpVectorDataToJson(dumpBasePath, GetDumpGenericFileName(DumpStrStat::SPLITTED), genericSplittedDumpData, splitTextPrefix);
-            DumpVectorDataToJson(dumpBasePath, GetDumpGenericFileName(DumpStrStat::FMT), genericFmtTextDumpData);
-            genericTextDumpData.clear();
-            genericSplittedDumpData.clear();
-            genericOrigTextDumpData.clear();
-            genericFmtTextDumpData.clear();
-            inDumpGeneric = false;
-        }).detach();
+    RegexCaptureBuffer& GetRegexCaptureBuffer() {
+        thread_local RegexCaptureBuffer buffer;
+        return buffer;
     }
 
-    bool GetGenericText(const std::string& origText, std::string* newStr) {
-        // 完全匹配
-        if (const auto iter = genericText.find(origText); iter != genericText.end()) {
-            *newStr = iter->second;
-            return true;
-        }
-        // TODO tmp masterText
-        if (const auto iter = masterText.find(origText); iter != masterText.end()) {
-            *newStr = iter->second;
+    // 命中时 GetRegexCaptureBuffer().captures 为本次的捕获组
+    bool TryRegexTranslation(const RegexTranslationItem& regexItem, const std::string& origText, std::string* newStr) {
+        if (!regexItem.regex || !regexItem.regex->ok()) return false;
+
+        const int numGroups = regexItem.captureGroups;
+        auto& buffer = GetRegexCaptureBuffer();
+        buffer.captures.clear();
+        try {
+            buffer.Reserve(numGroups);
+            if (!re2::RE2::FullMatchN(origText, *regexItem.regex, buffer.argPointers.data(), numGroups)) {
+                return false;
+            }
+            if (numGroups == 0) {
+                Log::WarnFmt("Hit generic regex: template is %s, regex is %s, text is %s", regexItem.originalKey.c_str(), regexItem.originalPattern.c_str(), origText.c_str());
+                *newStr = regexItem.translation;
+                return true;
+            }
+            for (int i = 0; i < numGroups; i++) {
+                buffer.captures.emplace_back(buffer.values[i].data(), buffer.values[i].size());
+            }
+            Log::VerboseFmt("FullMatch completed (%d groups), result: true", numGroups);
+            regexItem.translationTemplate.Render(regexItem.translation, buffer.captures, newStr);
             return true;
-        }
-        // 不翻译翻译过的文本
-        if (translatedText.contains(origText)) {
+        } catch (const std::exception& e) {
+            Log::ErrorFmt("Exception in FullMatch: %s", e.what());
+            return false;
+        } catch (...) {
+            Log::ErrorFmt("Unknown exception in FullMatch");
             return false;
         }
+    }
 
-        // 匹配升级卡名
-        if (auto plusPos = origText.find_last_not_of('+'); plusPos != std::string::npos) {
-            const auto noPlusText = origText.substr(0, plusPos + 1);
-
-            if (const auto iter = genericText.find(noPlusText); iter != genericText.end()) {
-                size_t plusCount = origText.length() - (plusPos + 1);
-                *newStr = iter->second + std::string(plusCount, '+');
-                return true;
-            }
+    // 捕获组恰好覆盖各段 FLAG 时，形状相同的文本会得到同样的匹配，之后可以直接按 FLAG 替换。
+    // captures 为 TryRegexTranslation 命中时的捕获组
+    bool MapRegexCapturesToFlags(std::span<const std::string_view> captures, const std::vector<std::string_view>& flagValues,
+                                 std::vector<uint8_t>* captureFlagIndex) {
+        if (captures.empty()) return false;
+        captureFlagIndex->clear();
+        for (const auto capture : captures) {
+            const auto it = std::ranges::find_if(flagValues, [&](std::string_view flag) {
+                return flag.data() == capture.data() && flag.size() == capture.size();
+            });
+            if (it == flagValues.end() || it - flagValues.begin() > UINT8_MAX) return false;
+            captureFlagIndex->push_back(static_cast<uint8_t>(it - flagValues.begin()));
         }
+        return true;
+    }
 
+    // fmt 模板和正则模板匹配，resolution 不为空时记录命中的模板
+    bool ResolveTextTemplateUncached(const TranslationSnapshot& snapshot, const std::string& origText, std::string* newStr,
+                                     const std::vector<std::string_view>& flagValues, ShapeResolution* resolution) {
         // fmt 文本
-        auto fmtText = StringParser::ParseItems::parse(origText, false);
+        std::string_view dictValue;
+        const auto fmtText = StringParser::ParseItems::parse(origText, false);
+        // 两种切分结果不一致时（例如非法 UTF-8）不记录
+        if (resolution && (!fmtText.isValid || !fmtText.ShapeEquals(resolution->shape))) {
+            resolution = nullptr;
+        }
         if (fmtText.isValid) {
-            const auto fmtStr = fmtText.ToFmtString();
-            if (auto it = genericFmtText.find(fmtStr); it != genericFmtText.end()) {
-                auto newRet = fmtText.MergeText(it->second);
+            // 直接按形状哈希查询，不拼出 fmt 文本
+            const auto shapeHash = resolution ? resolution->hash : fmtText.ShapeHash();
+            const auto shapeEquals = [&fmtText](std::string_view key) {
+                return fmtText.ShapeEquals(key);
+            };
+            if (snapshot.dict && snapshot.dict->FindHashed(DictTable::Fmt, shapeHash, shapeEquals, &dictValue)) {
+                auto newRet = fmtText.MergeText(dictValue);
                 if (!newRet.empty()) {
-                    *newStr = newRet;
+                    *newStr = std::move(newRet);
+                    if (resolution) {
+                        resolution->kind = ShapeResolutionKind::Fmt;
+                        resolution->fmtTemplate = dictValue;
+                    }
                     return true;
                 }
             }
             if (Config::dumpText) {
-                DumpGenericText(fmtStr, DumpStrStat::FMT);
+                DumpGenericText(snapshot, fmtText.ToFmtString(), DumpStrStat::FMT);
             }
         }
-//        Log::VerboseFmt("Try to get generic text from regex: %s", origText.c_str());
-        for (const auto& regexItem : regexText) {
-            if (regexItem.regex && regexItem.regex->ok()) {
-                // Log::VerboseFmt("Debug log in match regex");
-
-                int numGroups = regexItem.regex->NumberOfCapturingGroups();
-                // Log::VerboseFmt("Debug log when go in to matching, pattern: %s, capturing groups: %d", regexItem.regex->pattern().c_str(), numGroups);
 
-                bool matchResult = false;
-                try {
-                    if (numGroups == 0) {
-                        matchResult = re2::RE2::FullMatch(origText, *regexItem.regex);
-//                        Log::VerboseFmt("FullMatch completed (no capture groups), result: %s", matchResult ? "true" : "false");
-                    } else if (numGroups == 1) {
-                        std::string match1;
-                        matchResult = re2::RE2::FullMatch(origText, *regexItem.regex, &match1);
-                        if (matchResult) {
-                            Log::VerboseFmt("FullMatch completed (1 group), result: true, match1: %s", match1.c_str());
-                            *newStr = regexItem.translation;
-                            ReplaceAllPlaceholders(newStr, 0, match1);
-                            return true;
-                        }
-                    } else if (numGroups == 2) {
-                        std::string match1, match2;
-                        matchResult = re2::RE2::FullMatch(origText, *regexItem.regex, &match1, &match2);
-                        if (matchResult) {
-                            Log::VerboseFmt("FullMatch completed (2 groups), result: true, match1: %s, match2: %s", match1.c_str(), match2.c_str());
-                            *newStr = regexItem.translation;
-                            ReplaceAllPlaceholders(newStr, 0, match1);
-                            ReplaceAllPlaceholders(newStr, 1, match2);
-                            return true;
-                        }
-                    } else if (numGroups == 3) {
-                        std::string match1, match2, match3;
-                        matchResult = re2::RE2::FullMatch(origText, *regexItem.regex, &match1, &match2, &match3);
-                        if (matchResult) {
-                            Log::VerboseFmt("FullMatch completed (3 groups), result: true, match1: %s, match2: %s, match3: %s", match1.c_str(), match2.c_str(), match3.c_str());
-                            *newStr = regexItem.translation;
-                            ReplaceAllPlaceholders(newStr, 0, match1);
-                            ReplaceAllPlaceholders(newStr, 1, match2);
-                            ReplaceAllPlaceholders(newStr, 2, match3);
-                            return true;
-                        }
-                    } else if (numGroups == 4) {
-                        std::string match1, match2, match3, match4;
-                        matchResult = re2::RE2::FullMatch(origText, *regexItem.regex, &match1, &match2, &match3, &match4);
-                        if (matchResult) {
-                            Log::VerboseFmt("FullMatch completed (4 groups), result: true");
-                            *newStr = regexItem.translation;
-                            ReplaceAllPlaceholders(newStr, 0, match1);
-                            ReplaceAllPlaceholders(newStr, 1, match2);
-                            ReplaceAllPlaceholders(newStr, 2, match3);
-                            ReplaceAllPlaceholders(newStr, 3, match4);
-                            return true;
-                        }
-                    } else {
-//                        Log::WarnFmt("Too many capture groups (%d), skipping regex match", numGroups);
-                        continue;
+//        Log::VerboseFmt("Try to get generic text from regex: %s", origText.c_str());
+        auto onRegexHit = [&](size_t index) {
+            // 比命中项优先级更高的模板里没有字面 FLAG 字符时，形状相同的文本一定命中同一项
+            if (resolution && index < snapshot.firstFlagLiteralRegex &&
+                MapRegexCapturesToFlags(GetRegexCaptureBuffer().captures, flagValues, &resolution->captureFlagIndex)) {
+                resolution->kind = ShapeResolutionKind::Regex;
+                resolution->regexIndex = index;
+            }
+            return true;
+        };
+        bool regexScanned = false;
+        if (snapshot.regexSet && !snapshot.regexSetFailed.load(std::memory_order_relaxed)) {
+            thread_local std::vector<int> regexHits;
+            regexHits.clear();
+            re2::RE2::Set::ErrorInfo errorInfo{};
+            if (snapshot.regexSet->Match(origText, &regexHits, &errorInfo)) {
+                // 保持 regexText 的先后顺序作为优先级
+                std::sort(regexHits.begin(), regexHits.end());
+                for (const auto hit : regexHits) {
+                    const auto index = snapshot.regexSetItemIndex[hit];
+                    if (TryRegexTranslation(snapshot.regexText[index], origText, newStr)) {
+                        return onRegexHit(index);
                     }
-
-//                    Log::VerboseFmt("FullMatch completed (%d capture groups), result: %s", numGroups, matchResult ? "true" : "false");
-                } catch (const std::exception& e) {
-                    Log::ErrorFmt("Exception in FullMatch: %s", e.what());
-                    continue;
-                } catch (...) {
-                    Log::ErrorFmt("Unknown exception in FullMatch");
-                    continue;
                 }
+                regexScanned = true;
+            }
+            else if (errorInfo.kind == re2::RE2::Set::kNoError) {
+                regexScanned = true;
+            }
+            else if (!snapshot.regexSetFailed.exchange(true, std::memory_order_relaxed)) {
+                Log::WarnFmt("RE2::Set match failed (%d), fallback to linear regex matching.", static_cast<int>(errorInfo.kind));
+            }
+        }
+        if (!regexScanned) {
+            for (size_t index = 0; index < snapshot.regexText.size(); index++) {
+                if (TryRegexTranslation(snapshot.regexText[index], origText, newStr)) {
+                    return onRegexHit(index);
+                }
+            }
+        }
+        if (resolution && snapshot.firstFlagLiteralRegex == snapshot.regexText.size()) {
+            resolution->kind = ShapeResolutionKind::NoMatch;
+        }
+        return false;
+    }
 
-                // 如果没有匹配成功但是到了这里，说明是无捕获组的情况
-                if (matchResult) {
-                    Log::WarnFmt("Hit generic regex: template is %s, regex is %s, text is %s", regexItem.originalKey.c_str(), regexItem.originalPattern.c_str(), origText.c_str());
-                    *newStr = regexItem.translation;
-                    return true;
+    bool ApplyShapeResolution(const TranslationSnapshot& snapshot, const ShapeResolution& resolution,
+                              const std::vector<std::string_view>& flagValues, std::string* newStr) {
+        switch (resolution.kind) {
+            case ShapeResolutionKind::Fmt: {
+                newStr->clear();
+                StringParser::AppendFormatted(resolution.fmtTemplate, flagValues, newStr);
+                return true;
+            }
+            case ShapeResolutionKind::Regex: {
+                thread_local std::vector<std::string_view> captures;
+                captures.clear();
+                for (const auto flagIndex : resolution.captureFlagIndex) {
+                    captures.push_back(flagValues[flagIndex]);
                 }
+                const auto& regexItem = snapshot.regexText[resolution.regexIndex];
+                regexItem.translationTemplate.Render(regexItem.translation, captures, newStr);
+                return true;
+            }
+            case ShapeResolutionKind::Unresolved:
+            case ShapeResolutionKind::NoMatch:
+                break;
+        }
+        return false;
+    }
+
+    // 计时、分数等每帧变化的文本每次都是新字符串，按形状记住命中的模板，之后直接替换 FLAG，
+    // 不再重复 fmt 解析和正则扫描
+    bool ResolveTextTemplate(const TranslationSnapshot& snapshot, const std::string& origText, std::string* newStr) {
+        thread_local std::string shape;
+        thread_local std::vector<std::string_view> flagValues;
+        // dump 模式下需要走完整流程把未翻译的 fmt 文本写出去
+        if (Config::dumpText || !StringParser::BuildFmtShape(origText, &shape, &flagValues)) {
+            return ResolveTextTemplateUncached(snapshot, origText, newStr, flagValues, nullptr);
+        }
+
+        const auto shapeHash = HashText(shape);
+        if (const auto resolution = snapshot.shapeCache->Find(shapeHash, shape)) {
+            return ApplyShapeResolution(snapshot, *resolution, flagValues, newStr);
+        }
+
+        auto resolution = std::make_unique<ShapeResolution>();
+        resolution->hash = shapeHash;
+        resolution->shape = shape;
+        const auto ret = ResolveTextTemplateUncached(snapshot, origText, newStr, flagValues, resolution.get());
+        if (resolution->kind != ShapeResolutionKind::Unresolved) {
+            snapshot.shapeCache->Insert(std::move(resolution));
+        }
+        return ret;
+    }
+
+    bool LookupGenericText(const TranslationSnapshot& snapshot, const std::string& origText, std::string* newStr) {
+        // 完全匹配
+        std::string_view dictValue;
+        if (FindDictText(snapshot, DictTable::Generic, origText, &dictValue)) {
+            *newStr = dictValue;
+            return true;
+        }
+        // TODO tmp masterText
+        if (FindDictText(snapshot, DictTable::Master, origText, &dictValue)) {
+            *newStr = dictValue;
+            return true;
+        }
+        // 不翻译翻译过的文本
+        if (IsTranslatedText(snapshot, origText)) {
+            return false;
+        }
+
+        // 匹配升级卡名
+        if (auto plusPos = origText.find_last_not_of('+'); plusPos != std::string::npos && plusPos + 1 < origText.size()) {
+            const auto noPlusText = std::string_view(origText).substr(0, plusPos + 1);
+
+            if (FindDictText(snapshot, DictTable::Generic, noPlusText, &dictValue)) {
+                size_t plusCount = origText.length() - (plusPos + 1);
+                newStr->assign(dictValue);
+                newStr->append(plusCount, '+');
+                return true;
             }
         }
+
+        if (ResolveTextTemplate(snapshot, origText, newStr)) {
+            return true;
+        }
         auto ret = false;
 
         // 分割匹配
         std::vector<std::string> unTransResultRet;
-        const auto splitTransStat = GetSplitTagsTranslationFull(origText, newStr, unTransResultRet);
+        const auto splitTransStat = GetSplitTagsTranslationFull(snapshot, origText, newStr, unTransResultRet);
         switch (splitTransStat) {
             case SplitTagsTranslationStat::FULL_TRANS: {
-                DumpGenericText(origText, DumpStrStat::SPLITTABLE_ORIG);
+                DumpGenericText(snapshot, origText, DumpStrStat::SPLITTABLE_ORIG);
                 return true;
             } break;
 
@@ -1054,21 +1518,92 @@ namespace LinkuraLocal::Local {
         }
 
         if (unTransResultRet.empty() || (splitTransStat == SplitTagsTranslationStat::NO_SPLIT)) {
-            DumpGenericText(origText);
+            DumpGenericText(snapshot, origText);
         }
         else {
             for (const auto& i : unTransResultRet) {
-                DumpGenericText(i, DumpStrStat::SPLITTED);
+                DumpGenericText(snapshot, i, DumpStrStat::SPLITTED);
             }
             // 若未翻译部分长度为1，且未翻译文本等于原文本，则不 dump 到原文本文件
             //if (unTransResultRet.size() != 1 || unTransResultRet[0] != origText) {
-                DumpGenericText(origText, DumpStrStat::SPLITTABLE_ORIG);
+                DumpGenericText(snapshot, origText, DumpStrStat::SPLITTABLE_ORIG);
             //}
         }
 
         return ret;
     }
 
+    // 数字、时间、百分比、空白和纯标点不查词典
+    template <typename Text>
+    bool IsUntranslatableText(Text text) {
+        classifiedCalls.fetch_add(1, std::memory_order_relaxed);
+        if (ClassifyText(text) == TextClass::Translatable) return false;
+        classifiedSkips.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool GetGenericText(const std::string& origText, std::string* newStr) {
+        if (IsUntranslatableText(std::string_view(origText))) return false;
+        const auto readGuard = snapshotReaders.Enter();
+        // 快照发布前原样显示
+        const auto snapshot = currentSnapshot.load(std::memory_order_acquire);
+        if (!snapshot) return false;
+
+        // dump 模式下每次都要走完整流程才能把未翻译文本写出去
+        if (Config::dumpText) {
+            return LookupGenericText(*snapshot, origText, newStr);
+        }
+        const auto fingerprint = MissCache::Fingerprint(origText, snapshot->generation);
+        if (missCache.Contains(fingerprint)) {
+            return false;
+        }
+        if (LookupGenericText(*snapshot, origText, newStr)) {
+            return true;
+        }
+        missCache.Insert(fingerprint);
+        return false;
+    }
+
+    // UTF-16 内容的未命中指纹，与 UTF-8 的指纹使用不同的种子
+    uint64_t Utf16MissFingerprint(std::u16string_view text, uint64_t generation) {
+        return MissCache::Fingerprint({reinterpret_cast<const char*>(text.data()), text.size() * sizeof(char16_t)}, ~generation);
+    }
+
+    bool GetGenericText(std::u16string_view origText, std::string* newStr) {
+        if (IsUntranslatableText(origText)) return false;
+        const auto readGuard = snapshotReaders.Enter();
+        const auto snapshot = currentSnapshot.load(std::memory_order_acquire);
+        if (!snapshot) return false;
+
+        // 完全匹配和已知未命中都不需要转码
+        std::string_view dictValue;
+        if (snapshot->dict && (snapshot->dict->FindUtf16(DictTable::Utf16Generic, origText, &dictValue) ||
+                               snapshot->dict->FindUtf16(DictTable::Utf16Master, origText, &dictValue))) {
+            *newStr = dictValue;
+            return true;
+        }
+        const bool useMissCache = !Config::dumpText;
+        uint64_t fingerprint = 0;
+        if (useMissCache) {
+            fingerprint = Utf16MissFingerprint(origText, snapshot->generation);
+            if (missCache.Contains(fingerprint)) {
+                return false;
+            }
+        }
+
+        thread_local std::string utf8Text;
+        if (!Utf::Utf16ToUtf8(origText, &utf8Text)) {
+            return false;
+        }
+        if (LookupGenericText(*snapshot, utf8Text, newStr)) {
+            return true;
+        }
+        if (useMissCache) {
+            missCache.Insert(fingerprint);
+        }
+        return false;
+    }
+
     std::string ChangeDumpTextIndex(int changeValue) {
         if (!Config::dumpText) return "";
         genericDumpFileIndex += changeValue;
@@ -1,20 +1,26 @@
 #ifndef LINKURA_LOCALIFY_LOCAL_H
 #define LINKURA_LOCALIFY_LOCAL_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <filesystem>
-#include <unordered_set>
 
 namespace LinkuraLocal::Local {
-    extern std::unordered_set<std::string> translatedText;
-
     std::filesystem::path GetBasePath();
+    // 同步构建并发布翻译快照
     void LoadData();
+    // 在后台线程中加载，并监视翻译文件变化自动重载；加载完成前 GetGenericText 原样返回
+    void StartLoadData();
+    // 当前翻译快照的版本号，每次（重新）加载后递增；尚未加载时为 0
+    uint64_t GetDataGeneration();
     bool GetI18n(const std::string& key, std::string* ret);
     void DumpI18nItem(const std::string& key, const std::string& value);
 
     bool GetResourceText(const std::string& name, std::string* ret);
     bool GetGenericText(const std::string& origText, std::string* newStr);
+    // 托管字符串直接传入 UTF-16 内容，完全匹配和已知未命中时不做转码
+    bool GetGenericText(std::u16string_view origText, std::string* newStr);
 
     std::string OnKeyDown(int message, int key);
 }
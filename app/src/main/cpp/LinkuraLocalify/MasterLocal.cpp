@@ -1,22 +1,32 @@
 #include "MasterLocal.h"
+#include <nlohmann/json.hpp>
 #include "Local.h"
 #include "Il2cppUtils.hpp"
+#include "local/ManagedStringCache.hpp"
 #include "config/Config.hpp"
+#include "local/Parallel.hpp"
+#include "local/FlatStringMap.hpp"
+#include "local/MasterKeyMap.hpp"
+#include "local/FingerprintSet.hpp"
+#include "local/ReaderEpoch.hpp"
+#include "local/WorkerPool.hpp"
+#include "utf/Utf.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <regex>
-#include <nlohmann/json.hpp>
+#include <optional>
 
 namespace LinkuraLocal::MasterLocal {
     using Il2cppString = UnityResolve::UnityType::String;
 
-    static std::unordered_map<std::string, Il2cppUtils::MethodInfo*> fieldSetCache;
-    static std::unordered_map<std::string, Il2cppUtils::MethodInfo*> fieldGetCache;
-
     enum class JsonValueType {
         JVT_String,
         JVT_Int,
@@ -41,8 +51,13 @@ namespace LinkuraLocal::MasterLocal {
         std::unordered_map<std::string, JsonValueType> mainKeyType;
         std::unordered_map<std::string, std::unordered_map<std::string, JsonValueType>> subKeyType;
 
-        std::unordered_map<std::string, std::string> transData;
-        std::unordered_map<std::string, std::vector<std::string>> transStrListData;
+        // 字段路径编号，与 itemRule.mainLocalKey / itemRule.subLocalKey 中的字段一一对应
+        std::vector<uint32_t> mainLocalPathIds;
+        std::map<std::string, std::vector<uint32_t>> subLocalPathIds;
+
+        // 以 (主键哈希, 路径编号, 数组下标) 为键，译文存放在各自表的 arena 中
+        Local::MasterKeyMap<std::string_view> transData;
+        Local::MasterKeyMap<std::vector<std::string_view>> transStrListData;
 
         [[nodiscard]] JsonValueType GetMainKeyType(const std::string& mainKey) const {
             if (auto it = mainKeyType.find(mainKey); it != mainKeyType.end()) {
@@ -61,172 +76,156 @@ namespace LinkuraLocal::MasterLocal {
         }
     };
 
-    static std::unordered_map<std::string, TableLocalData> masterLocalData;
+    // 一张 masterTrans 表。登记时只记录路径，第一次查询时才解析，之后不再变化
+    class MasterTableEntry {
+    public:
+        MasterTableEntry(std::string tableName, std::filesystem::path path)
+                : tableName(std::move(tableName)), path(std::move(path)) {}
+
+        // 尚未加载时在当前线程加载，同一张表的并发调用等待同一次加载。
+        // loadedNow 不为空时，本次调用完成了加载则置为 true
+        const TableLocalData* Get(bool* loadedNow = nullptr);
+
+        [[nodiscard]] const std::string& Name() const { return tableName; }
+
+    private:
+        std::string tableName;
+        std::filesystem::path path;
+        std::atomic<const TableLocalData*> loaded{nullptr};
+        std::atomic<bool> failed{false};
+        std::mutex loadMutex;
+        std::unique_ptr<TableLocalData> data{};
+    };
 
-    class FieldController {
-        void* self;
-        std::string self_klass_name;
+    // 一次登记的全部表。重新登记时整体替换，旧的等读区间内的读者离开后释放
+    struct MasterTableRegistry {
+        Local::FlatStringMap<std::unique_ptr<MasterTableEntry>> tables{};
+        // 已加载的表中所有译文的指纹，合并为一个集合，查询只需一次探测。
+        // 每加载一张表，在 translatedTextMutex 下复制当前集合、追加新表后整体替换；
+        // 读者在 translatedTextReaders 的读区间内无锁访问，旧集合等读者离开后释放
+        std::atomic<const Local::FingerprintSet*> translatedText{nullptr};
+        std::unique_ptr<const Local::FingerprintSet> translatedTextOwner{};
+        std::mutex translatedTextMutex;
+        // 预加载列表文件，记录用到过的表名，下次启动时在后台预先加载
+        std::filesystem::path prefetchFile{};
+        std::mutex usedTablesMutex;
+        std::unordered_set<std::string> usedTables{};
+        std::atomic<bool> retired{false};
+    };
 
-        static std::string capitalizeFirstLetter(const std::string& input) {
+    // 钩子线程在 registryReaders 的读区间内做一次 acquire load，不加锁
+    static std::atomic<MasterTableRegistry*> currentRegistry{nullptr};
+    static Local::ReaderEpoch registryReaders{};
+    // 只保护 MasterTableRegistry::translatedText。与 registryReaders 分开，
+    // 加载表的线程（处于 registryReaders 的读区间内）才能等待旧集合的读者离开
+    static Local::ReaderEpoch translatedTextReaders{};
+
+    // 表每次重新登记后递增，已编译的访问计划随之失效
+    static std::atomic<uint64_t> masterDataGeneration{0};
+
+    // 一个字段的访问方式：优先使用属性的 get_/set_ 方法，找不到时退回到 backing field（字段名 + '_'）。
+    // 按 (il2cpp 类, 字段名) 解析一次，之后读写只是一次函数指针调用或偏移访问
+    struct FieldAccessor {
+        Il2cppUtils::MethodInfo* getter = nullptr;
+        Il2cppUtils::MethodInfo* setter = nullptr;
+        Il2cppUtils::FieldInfo* field = nullptr;
+        // 声明的值类型（getter 的返回类型或字段类型），用来预先编译子对象的计划
+        Il2cppUtils::Il2CppClassHead* valueClass = nullptr;
+        // getter 返回枚举时按枚举值排序的 (值, "类型名_成员名")，读字符串时返回成员名
+        bool isEnum = false;
+        std::vector<std::pair<int, std::string>> enumNames{};
+
+        static std::string CapitalizeFirstLetter(const std::string& input) {
             if (input.empty()) return input;
             std::string result = input;
             result[0] = static_cast<char>(std::toupper(result[0]));
             return result;
         }
 
-        Il2cppUtils::MethodInfo* GetGetSetMethodFromCache(const std::string& fieldName, int argsCount,
-                                                          std::unordered_map<std::string, Il2cppUtils::MethodInfo*>& fromCache, const std::string& prefix = "set_") {
-            const std::string methodName = prefix + capitalizeFirstLetter(fieldName);
-            const std::string searchName = self_klass_name + "." + methodName;
-
-            if (auto it = fromCache.find(searchName); it != fromCache.end()) {
-                return it->second;
+        static FieldAccessor Resolve(Il2cppUtils::Il2CppClassHead* klass, const std::string& fieldName) {
+            FieldAccessor ret{};
+            if (!klass) return ret;
+            const auto propertyName = CapitalizeFirstLetter(fieldName);
+            ret.getter = Il2cppUtils::il2cpp_class_get_method_from_name(klass, ("get_" + propertyName).c_str(), 0);
+            ret.setter = Il2cppUtils::il2cpp_class_get_method_from_name(klass, ("set_" + propertyName).c_str(), 1);
+            if (!ret.getter || !ret.setter) {
+                ret.field = UnityResolve::Invoke<Il2cppUtils::FieldInfo*>(
+                        "il2cpp_class_get_field_from_name",
+                        klass,
+                        (fieldName + '_').c_str()
+                );
             }
-            auto set_mtd = Il2cppUtils::il2cpp_class_get_method_from_name(
-                    self_klass,
-                    methodName.c_str(),
-                    argsCount
-            );
-            fromCache.emplace(searchName, set_mtd);
-            return set_mtd;
-        }
-
-    public:
-        Il2cppUtils::Il2CppClassHead* self_klass;
-
-        explicit FieldController(void* from) {
-            if (!from) {
-                self = nullptr;
-                return;
+            if (ret.getter) {
+                ret.valueClass = UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>(
+                        "il2cpp_class_from_type",
+                        UnityResolve::Invoke<void*>("il2cpp_method_get_return_type", ret.getter)
+                );
+                if (ret.valueClass && UnityResolve::Invoke<bool>("il2cpp_class_is_enum", ret.valueClass)) {
+                    ret.isEnum = true;
+                    const auto enumMap = Il2cppUtils::EnumToValueMap(ret.valueClass, true);
+                    ret.enumNames.assign(enumMap.begin(), enumMap.end());
+                    std::ranges::sort(ret.enumNames, {}, &std::pair<int, std::string>::first);
+                }
             }
-            self = from;
-            self_klass = Il2cppUtils::get_class_from_instance(self);
-            if (self_klass) {
-                self_klass_name = self_klass->name;
+            else if (ret.field) {
+                ret.valueClass = UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>(
+                        "il2cpp_class_from_type",
+                        UnityResolve::Invoke<void*>("il2cpp_field_get_type", ret.field)
+                );
             }
+            return ret;
         }
 
         template<typename T>
-        T ReadField(const std::string& fieldName) {
-            if (!self) return T();
-            auto get_mtd = GetGetSetMethodFromCache(fieldName, 0, fieldGetCache, "get_");
-            if (get_mtd) {
-                return reinterpret_cast<T (*)(void*, void*)>(get_mtd->methodPointer)(self, get_mtd);
+        T Read(void* self) const {
+            if (getter) {
+                return reinterpret_cast<T (*)(void*, void*)>(getter->methodPointer)(self, getter);
             }
-
-            auto field = UnityResolve::Invoke<Il2cppUtils::FieldInfo*>(
-                    "il2cpp_class_get_field_from_name",
-                    self_klass,
-                    (fieldName + '_').c_str()
-            );
-            if (!field) {
-                return T();
+            if (field) {
+                return Il2cppUtils::ClassGetFieldValue<T>(self, field);
             }
-            return Il2cppUtils::ClassGetFieldValue<T>(self, field);
+            return T();
         }
 
         template<typename T>
-        void SetField(const std::string& fieldName, T value) {
-            if (!self) return;
-            auto set_mtd = GetGetSetMethodFromCache(fieldName, 1, fieldSetCache, "set_");
-            if (set_mtd) {
-                reinterpret_cast<void (*)(void*, T, void*)>(
-                        set_mtd->methodPointer
-                )(self, value, set_mtd);
+        void Write(void* self, T value) const {
+            if (setter) {
+                reinterpret_cast<void (*)(void*, T, void*)>(setter->methodPointer)(self, value, setter);
                 return;
             }
-            auto field = UnityResolve::Invoke<Il2cppUtils::FieldInfo*>(
-                    "il2cpp_class_get_field_from_name",
-                    self_klass,
-                    (fieldName + '_').c_str()
-            );
-            if (!field) return;
-            Il2cppUtils::ClassSetFieldValue(self, field, value);
-        }
-
-        int ReadIntField(const std::string& fieldName) {
-            return ReadField<int>(fieldName);
-        }
-
-        Il2cppString* ReadStringField(const std::string& fieldName) {
-            if (!self) return nullptr;
-            auto get_mtd = GetGetSetMethodFromCache(fieldName, 0, fieldGetCache, "get_");
-            if (!get_mtd) {
-                return ReadField<Il2cppString*>(fieldName);
-            }
-            auto returnClass = UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>(
-                    "il2cpp_class_from_type",
-                    UnityResolve::Invoke<void*>("il2cpp_method_get_return_type", get_mtd)
-            );
-            if (!returnClass) {
-                return reinterpret_cast<Il2cppString* (*)(void*, void*)>(
-                        get_mtd->methodPointer
-                )(self, get_mtd);
-            }
-            auto isEnum = UnityResolve::Invoke<bool>("il2cpp_class_is_enum", returnClass);
-            if (!isEnum) {
-                return reinterpret_cast<Il2cppString* (*)(void*, void*)>(
-                        get_mtd->methodPointer
-                )(self, get_mtd);
-            }
-            auto enumMap = Il2cppUtils::EnumToValueMap(returnClass, true);
-            auto enumValue = reinterpret_cast<int (*)(void*, void*)>(
-                    get_mtd->methodPointer
-            )(self, get_mtd);
-            if (auto it = enumMap.find(enumValue); it != enumMap.end()) {
-                return Il2cppString::New(it->second);
+            if (field) {
+                Il2cppUtils::ClassSetFieldValue(self, field, value);
             }
-            return nullptr;
         }
 
-        void SetStringField(const std::string& fieldName, const std::string& value) {
-            if (!self) return;
-            auto newString = Il2cppString::New(value);
-            SetField(fieldName, newString);
-        }
-
-        void SetStringListField(const std::string& fieldName, const std::vector<std::string>& data) {
-            if (!self) return;
-            static auto List_String_klass = Il2cppUtils::get_system_class_from_reflection_type_str(
-                    "System.Collections.Generic.List`1[System.String]"
-            );
-            static auto List_String_ctor_mtd = Il2cppUtils::il2cpp_class_get_method_from_name(
-                    List_String_klass, ".ctor", 0
-            );
-            static auto List_String_ctor = reinterpret_cast<void (*)(void*, void*)>(
-                    List_String_ctor_mtd->methodPointer
-            );
-
-            auto newList = UnityResolve::Invoke<void*>("il2cpp_object_new", List_String_klass);
-            List_String_ctor(newList, List_String_ctor_mtd);
-
-            Il2cppUtils::Tools::CSListEditor<Il2cppString*> newListEditor(newList);
-            for (auto& s : data) {
-                newListEditor.Add(Il2cppString::New(s));
-            }
-            SetField(fieldName, newList);
-        }
-
-        void* ReadObjectField(const std::string& fieldName) {
-            if (!self) return nullptr;
-            return ReadField<void*>(fieldName);
-        }
-
-        void* ReadObjectListField(const std::string& fieldName) {
-            if (!self) return nullptr;
-            return ReadField<void*>(fieldName);
-        }
-
-        static FieldController CreateSubFieldController(void* subObj) {
-            return FieldController(subObj);
-        }
-
-        FieldController CreateSubFieldController(const std::string& subObjName) {
-            auto field = ReadObjectField(subObjName);
-            return FieldController(field);
+        // 枚举值对应的成员名，不存在时返回空
+        [[nodiscard]] std::string_view EnumName(int value) const {
+            const auto it = std::ranges::lower_bound(enumNames, value, {}, &std::pair<int, std::string>::first);
+            if (it == enumNames.end() || it->first != value) return {};
+            return it->second;
         }
     };
 
+    void* NewManagedStringList(const std::vector<std::string_view>& data) {
+        static auto List_String_klass = Il2cppUtils::get_system_class_from_reflection_type_str(
+                "System.Collections.Generic.List`1[System.String]"
+        );
+        static auto List_String_ctor_mtd = Il2cppUtils::il2cpp_class_get_method_from_name(
+                List_String_klass, ".ctor", 0
+        );
+        static auto List_String_ctor = reinterpret_cast<void (*)(void*, void*)>(
+                List_String_ctor_mtd->methodPointer
+        );
+
+        auto newList = UnityResolve::Invoke<void*>("il2cpp_object_new", List_String_klass);
+        List_String_ctor(newList, List_String_ctor_mtd);
+
+        Il2cppUtils::Tools::CSListEditor<Il2cppString*> newListEditor(newList);
+        for (const auto s : data) {
+            newListEditor.Add(Local::GetManagedString(s));
+        }
+        return newList;
+    }
 
     JsonValueType checkJsonValueType(const nlohmann::json& j) {
         if (j.is_string())  return JsonValueType::JVT_String;
@@ -249,81 +248,80 @@ namespace LinkuraLocal::MasterLocal {
     }
 
 
-    std::string ReadFileToString(const std::filesystem::path& path) {
-        std::ifstream ifs(path, std::ios::binary);
-        if (!ifs) return {};
-        std::stringstream buffer;
-        buffer << ifs.rdbuf();
-        return buffer.str();
-    }
-
     namespace Load {
-        std::vector<std::string> ArrayStrJsonToVec(nlohmann::json& data) {
-            return data;
+        // 数组中的字符串存入 transStrListData 的 arena
+        std::vector<std::string_view> ArrayStrJsonToVec(nlohmann::json& data, TableLocalData& tableLocalData) {
+            const auto& items = data.get_ref<const nlohmann::json::array_t&>();
+            std::vector<std::string_view> ret;
+            ret.reserve(items.size());
+            for (const auto& i : items) {
+                ret.push_back(tableLocalData.transStrListData.Store(i.get_ref<const std::string&>()));
+            }
+            return ret;
         }
 
-        bool BuildObjectItemLocalRule(nlohmann::json& transData, ItemRule& itemRule) {
-            // transData: data[]
+        bool BuildObjectItemLocalRule(nlohmann::json& transData, ItemRule& itemRule);
+
+        // 从 data 中的一行推断需要本地化的字段，成功时返回 true
+        bool BuildRowLocalRule(nlohmann::json& data, ItemRule& itemRule) {
+            // data: {"id": "xxx", "produceDescriptions": [{"k", "v"}], "descriptions": {"k2", "v2"}}
             bool hasSuccess = false;
-            for (auto& data : transData) {
-                // data: {"id": "xxx", "produceDescriptions": [{"k", "v"}], "descriptions": {"k2", "v2"}}
-                if (!data.is_object()) continue;
-                for (auto& [key, value] : data.items()) {
-                    // key: "id", value: "xxx"
-                    // key: "produceDescriptions", value: [{"k", "v"}]
-                    const auto valueType = checkJsonValueType(value);
-                    switch (valueType) {
-                        case JsonValueType::JVT_String:
-                            // case JsonValueType::JVT_Int:
-                        case JsonValueType::JVT_ArrayString: {
-                            if (std::find(itemRule.mainPrimaryKey.begin(), itemRule.mainPrimaryKey.end(), key) != itemRule.mainPrimaryKey.end()) {
-                                continue;
-                            }
-                            if (auto it = std::find(itemRule.mainLocalKey.begin(), itemRule.mainLocalKey.end(), key); it == itemRule.mainLocalKey.end()) {
-                                itemRule.mainLocalKey.emplace_back(key);
-                            }
+            for (auto& [key, value] : data.items()) {
+                // key: "id", value: "xxx"
+                // key: "produceDescriptions", value: [{"k", "v"}]
+                const auto valueType = checkJsonValueType(value);
+                switch (valueType) {
+                    case JsonValueType::JVT_String:
+                        // case JsonValueType::JVT_Int:
+                    case JsonValueType::JVT_ArrayString: {
+                        if (std::find(itemRule.mainPrimaryKey.begin(), itemRule.mainPrimaryKey.end(), key) != itemRule.mainPrimaryKey.end()) {
+                            continue;
+                        }
+                        if (auto it = std::find(itemRule.mainLocalKey.begin(), itemRule.mainLocalKey.end(), key); it == itemRule.mainLocalKey.end()) {
+                            itemRule.mainLocalKey.emplace_back(key);
+                        }
+                        hasSuccess = true;
+                    } break;
+
+                    case JsonValueType::JVT_Object: {
+                        ItemRule currRule{ .mainPrimaryKey = itemRule.subPrimaryKey[key] };
+                        if (BuildRowLocalRule(value, currRule)) {
+                            itemRule.subLocalKey.emplace(key, currRule.mainLocalKey);
                             hasSuccess = true;
-                        } break;
+                        }
+                    } break;
 
-                        case JsonValueType::JVT_Object: {
+                    case JsonValueType::JVT_ArrayObject: {
+                        for (auto& obj : value) {
+                            // obj: {"k", "v"}
                             ItemRule currRule{ .mainPrimaryKey = itemRule.subPrimaryKey[key] };
-
-                            auto vJson = nlohmann::json::array();
-                            vJson.push_back(value);
-
-                            if (BuildObjectItemLocalRule(vJson, currRule)) {
+                            if (BuildObjectItemLocalRule(value, currRule)) {
                                 itemRule.subLocalKey.emplace(key, currRule.mainLocalKey);
                                 hasSuccess = true;
+                                break;
                             }
-                        } break;
-
-                        case JsonValueType::JVT_ArrayObject: {
-                            for (auto& obj : value) {
-                                // obj: {"k", "v"}
-                                ItemRule currRule{ .mainPrimaryKey = itemRule.subPrimaryKey[key] };
-                                if (BuildObjectItemLocalRule(value, currRule)) {
-                                    itemRule.subLocalKey.emplace(key, currRule.mainLocalKey);
-                                    hasSuccess = true;
-                                    break;
-                                }
-                            }
-                        } break;
+                        }
+                    } break;
 
-                        case JsonValueType::JVT_Unsupported:
-                        default:
-                            break;
-                    }
+                    case JsonValueType::JVT_Unsupported:
+                    default:
+                        break;
                 }
-                if (hasSuccess) break;
             }
             return hasSuccess;
         }
 
-        bool GetItemRule(nlohmann::json& fullData, ItemRule& itemRule) {
-            auto& primaryKeys = fullData["rules"]["primaryKeys"];
-            auto& transData = fullData["data"];
+        bool BuildObjectItemLocalRule(nlohmann::json& transData, ItemRule& itemRule) {
+            // transData: data[]
+            for (auto& data : transData) {
+                if (!data.is_object()) continue;
+                if (BuildRowLocalRule(data, itemRule)) return true;
+            }
+            return false;
+        }
+
+        bool ParsePrimaryKeyRules(const nlohmann::json& primaryKeys, ItemRule& itemRule) {
             if (!primaryKeys.is_array()) return false;
-            if (!transData.is_array()) return false;
 
             // 首先构造 mainPrimaryKey 规则
             for (auto& pkItem : primaryKeys) {
@@ -349,33 +347,50 @@ namespace LinkuraLocal::MasterLocal {
                     continue;
                 }
             }
-            return BuildObjectItemLocalRule(transData, itemRule);
+            return true;
         }
 
-        std::string BuildBaseMainUniqueKey(nlohmann::json& data, TableLocalData& tableLocalData) {
+        // 给规则中的每个本地化字段分配路径编号，之后加载和查询都只用编号
+        void InternFieldPaths(TableLocalData& tableLocalData) {
+            uint32_t nextPathId = 0;
+            for (size_t i = 0; i < tableLocalData.itemRule.mainLocalKey.size(); i++) {
+                tableLocalData.mainLocalPathIds.push_back(nextPathId++);  // name
+            }
+            for (const auto& [subLocalParentKey, subLocalSubKeys] : tableLocalData.itemRule.subLocalKey) {
+                auto& pathIds = tableLocalData.subLocalPathIds[subLocalParentKey];
+                for (size_t i = 0; i < subLocalSubKeys.size(); i++) {
+                    pathIds.push_back(nextPathId++);  // produceDescriptions|text
+                }
+            }
+        }
+
+        std::optional<uint64_t> BuildPrimaryKeyHash(nlohmann::json& data, TableLocalData& tableLocalData, uint64_t seed = 0) {
             try {
-                std::string mainBaseUniqueKey;
+                if (tableLocalData.itemRule.mainPrimaryKey.empty()) return std::nullopt;
+                uint64_t primaryKeyHash = 0;
                 for (auto& mainPrimaryKey : tableLocalData.itemRule.mainPrimaryKey) {
                     if (!data.contains(mainPrimaryKey)) {
-                        return "";
+                        return std::nullopt;
                     }
                     auto& value = data[mainPrimaryKey];
                     if (value.is_number_integer()) {
-                        mainBaseUniqueKey.append(std::to_string(value.get<int>()));
+                        primaryKeyHash = Local::MixPrimaryKeyPart(primaryKeyHash, value.get<int>(), seed);
                     }
                     else {
-                        mainBaseUniqueKey.append(value);
+                        primaryKeyHash = Local::MixPrimaryKeyPart(primaryKeyHash, value.get_ref<const std::string&>(), seed);
                     }
-                    mainBaseUniqueKey.push_back('|');
                 }
-                return mainBaseUniqueKey;
+                return primaryKeyHash;
             }
             catch (std::exception& e) {
-                Log::ErrorFmt("LoadData - BuildBaseMainUniqueKey failed: %s", e.what());
+                Log::ErrorFmt("LoadData - BuildPrimaryKeyHash failed: %s", e.what());
                 throw e;
             }
         }
 
+        // 校验哈希的种子，与主键哈希相互独立
+        constexpr uint64_t kPrimaryKeyCheckSeed = 0x9e3779b97f4a7c15ULL;
+
         void BuildBaseObjectSubUniqueKey(nlohmann::json& value, JsonValueType valueType, std::string& currLocalKey) {
             switch (valueType) {
                 case JsonValueType::JVT_String:
@@ -391,19 +406,31 @@ namespace LinkuraLocal::MasterLocal {
             }
         }
 
-        bool BuildUniqueKeyValue(nlohmann::json& data, TableLocalData& tableLocalData) {
+        // primaryKeyChecks: 本表中已出现的主键哈希 -> 校验哈希，用于发现不同主键的哈希碰撞，加载完即释放
+        bool BuildUniqueKeyValue(nlohmann::json& data, TableLocalData& tableLocalData,
+                                 std::unordered_map<uint64_t, uint64_t>& primaryKeyChecks) {
             // 首先处理 main 部分
-            const std::string mainBaseUniqueKey = BuildBaseMainUniqueKey(data, tableLocalData);  // p_card-00-acc-0_002|0|
-            if (mainBaseUniqueKey.empty()) return false;
-            for (auto& mainLocalKey : tableLocalData.itemRule.mainLocalKey) {
+            const auto primaryKeyHash = BuildPrimaryKeyHash(data, tableLocalData);  // p_card-00-acc-0_002|0|
+            if (!primaryKeyHash) return false;
+            const auto primaryKeyCheck = *BuildPrimaryKeyHash(data, tableLocalData, kPrimaryKeyCheckSeed);
+            if (const auto [it, inserted] = primaryKeyChecks.try_emplace(*primaryKeyHash, primaryKeyCheck);
+                    !inserted && it->second != primaryKeyCheck) {
+                Log::ErrorFmt("BuildUniqueKeyValue: primary key hash collision, skipped: %s", data.dump().c_str());
+                return false;
+            }
+            for (size_t i = 0; i < tableLocalData.itemRule.mainLocalKey.size(); i++) {
+                const auto& mainLocalKey = tableLocalData.itemRule.mainLocalKey[i];
                 if (!data.contains(mainLocalKey)) continue;
                 auto& currLocalValue = data[mainLocalKey];
-                auto currUniqueKey = mainBaseUniqueKey + mainLocalKey;  // p_card-00-acc-0_002|0|name
+                const Local::MasterKey currUniqueKey{  // p_card-00-acc-0_002|0|name
+                        .primaryKeyHash = *primaryKeyHash,
+                        .pathId = tableLocalData.mainLocalPathIds[i]
+                };
                 if (tableLocalData.GetMainKeyType(mainLocalKey) == JsonValueType::JVT_ArrayString) {
-                    tableLocalData.transStrListData.emplace(currUniqueKey, ArrayStrJsonToVec(currLocalValue));
+                    tableLocalData.transStrListData.Emplace(currUniqueKey, ArrayStrJsonToVec(currLocalValue, tableLocalData));
                 }
                 else {
-                    tableLocalData.transData.emplace(currUniqueKey, currLocalValue);
+                    tableLocalData.transData.EmplaceText(currUniqueKey, currLocalValue.get_ref<const std::string&>());
                 }
             }
             // 然后处理 sub 部分
@@ -441,39 +468,44 @@ namespace LinkuraLocal::MasterLocal {
             for (const auto& [subLocalParentKey, subLocalSubKeys] : tableLocalData.itemRule.subLocalKey) {
                 if (!data.contains(subLocalParentKey)) continue;
 
-                const std::string subBaseUniqueKey = mainBaseUniqueKey + subLocalParentKey + '|';  // p_card-00-acc-0_002|0|produceDescriptions|
+                const auto& subLocalPathIds = tableLocalData.subLocalPathIds.at(subLocalParentKey);
                 auto subValueType = checkJsonValueType(data[subLocalParentKey]);
                 if (subValueType != JsonValueType::JVT_NeedMore_EmptyArray) {
                     tableLocalData.mainKeyType.emplace(subLocalParentKey, subValueType);  // 在这里插入 subParent 的类型
                 }
                 switch (subValueType) {
                     case JsonValueType::JVT_Object: {
-                        for (auto& localSubKey : subLocalSubKeys) {
-                            const std::string currLocalUniqueKey = subBaseUniqueKey + localSubKey;  // p_card-00-acc-0_002|0|produceDescriptions|text
+                        for (size_t i = 0; i < subLocalSubKeys.size(); i++) {
+                            const auto& localSubKey = subLocalSubKeys[i];
+                            const Local::MasterKey currLocalUniqueKey{  // p_card-00-acc-0_002|0|produceDescriptions|text
+                                    .primaryKeyHash = *primaryKeyHash,
+                                    .pathId = subLocalPathIds[i]
+                            };
                             if (tableLocalData.GetSubKeyType(subLocalParentKey, localSubKey) == JsonValueType::JVT_ArrayString) {
-                                tableLocalData.transStrListData.emplace(currLocalUniqueKey, ArrayStrJsonToVec(data[subLocalParentKey][localSubKey]));
+                                tableLocalData.transStrListData.Emplace(currLocalUniqueKey, ArrayStrJsonToVec(data[subLocalParentKey][localSubKey], tableLocalData));
                             }
                             else {
-                                tableLocalData.transData.emplace(currLocalUniqueKey, data[subLocalParentKey][localSubKey]);
+                                tableLocalData.transData.EmplaceText(currLocalUniqueKey, data[subLocalParentKey][localSubKey].get_ref<const std::string&>());
                             }
                         }
                     } break;
                     case JsonValueType::JVT_ArrayObject: {
                         int currIndex = 0;
                         for (auto& obj : data[subLocalParentKey]) {
-                            for (auto& localSubKey : subLocalSubKeys) {
-                                std::string currLocalUniqueKey = subBaseUniqueKey;  // p_card-00-acc-0_002|0|produceDescriptions|
-                                currLocalUniqueKey.push_back('[');
-                                currLocalUniqueKey.append(std::to_string(currIndex));
-                                currLocalUniqueKey.append("]|");
-                                currLocalUniqueKey.append(localSubKey);  // p_card-00-acc-0_002|0|produceDescriptions|[0]|text
+                            for (size_t i = 0; i < subLocalSubKeys.size(); i++) {
+                                const auto& localSubKey = subLocalSubKeys[i];
+                                const Local::MasterKey currLocalUniqueKey{  // p_card-00-acc-0_002|0|produceDescriptions|[0]|text
+                                        .primaryKeyHash = *primaryKeyHash,
+                                        .pathId = subLocalPathIds[i],
+                                        .arrayIndex = currIndex
+                                };
 
                                 if (tableLocalData.GetSubKeyType(subLocalParentKey, localSubKey) == JsonValueType::JVT_ArrayString) {
                                     // if (obj[localSubKey].is_array()) {
-                                    tableLocalData.transStrListData.emplace(currLocalUniqueKey, ArrayStrJsonToVec(obj[localSubKey]));
+                                    tableLocalData.transStrListData.Emplace(currLocalUniqueKey, ArrayStrJsonToVec(obj[localSubKey], tableLocalData));
                                 }
                                 else if (obj[localSubKey].is_string()) {
-                                    tableLocalData.transData.emplace(currLocalUniqueKey, obj[localSubKey]);
+                                    tableLocalData.transData.EmplaceText(currLocalUniqueKey, obj[localSubKey].get_ref<const std::string&>());
                                 }
                             }
                             currIndex++;
@@ -517,293 +549,864 @@ namespace LinkuraLocal::MasterLocal {
                     } \
                 }
 
-        bool GetTableLocalData(nlohmann::json& fullData, TableLocalData& tableLocalData) {
+        enum class KeyTypeState {
+            Done,
+            NeedMore,  // 本行的主键或译文是空数组，换下一行继续判断
+            Failed
+        };
+
+        // 用一行数据确定 mainKeyType 和 subKeyType
+        KeyTypeState DetectKeyTypes(nlohmann::json& data, TableLocalData& tableLocalData) {
             bool isFailed = false;
 
-            // 首先 Build mainKeyType 和 subKeyType
-            for (auto& data : fullData["data"]) {
-                if (!data.is_object()) continue;
+            for (auto& mainPrimaryKey : tableLocalData.itemRule.mainPrimaryKey) {
+                MainKeyTypeProcess();
+            }
+            for (auto& mainPrimaryKey : tableLocalData.itemRule.mainLocalKey) {
+                MainKeyTypeProcess();
+            }
 
-                for (auto& mainPrimaryKey : tableLocalData.itemRule.mainPrimaryKey) {
-                    MainKeyTypeProcess();
+            for (const auto& [subKeyParent, subKeys] : tableLocalData.itemRule.subPrimaryKey) {
+                SubKeyTypeProcess()
+
+                if (isFailed) break;
+            }
+            for (const auto& [subKeyParent, subKeys] : tableLocalData.itemRule.subLocalKey) {
+                SubKeyTypeProcess()
+                if (isFailed) break;
+            }
+            if (!isFailed) return KeyTypeState::Done;
+        NextLoop:
+            return isFailed ? KeyTypeState::Failed : KeyTypeState::NeedMore;
+        }
+
+        // 逐行接收 data 中的对象构造 TableLocalData，不持有整张表的 json。
+        // 推断规则和字段类型之前的行暂存在 pendingRows，确定之后直接写入 transData
+        class TableBuilder {
+        public:
+            explicit TableBuilder(const std::string& tableName) : tableName(tableName) {}
+
+            void OnRules(nlohmann::json& rules) {
+                hasRules = rules.is_object() && rules.contains("primaryKeys");
+                if (!hasRules) return;
+                if (!ParsePrimaryKeyRules(rules["primaryKeys"], itemRule)) {
+                    rulesFailed = true;
+                    return;
                 }
-                for (auto& mainPrimaryKey : tableLocalData.itemRule.mainLocalKey) {
-                    MainKeyTypeProcess();
+                rulesParsed = true;
+                for (auto& row : pendingRows) {
+                    if (tableLocalData) break;
+                    TryBuildRule(row);
                 }
+                FlushPendingRows();
+            }
 
-                for (const auto& [subKeyParent, subKeys] : tableLocalData.itemRule.subPrimaryKey) {
-                    SubKeyTypeProcess()
+            void OnDataArray() {
+                hasDataArray = true;
+            }
 
-                    if (isFailed) break;
+            // 返回 false 时表已无法加载，调用方应停止解析
+            bool OnRow(nlohmann::json& row) {
+                if (typeState == KeyTypeState::Failed) return false;
+                if (!row.is_object()) return true;
+                if (typeState == KeyTypeState::Done) {
+                    AddRow(row);
+                    return true;
                 }
-                for (const auto& [subKeyParent, subKeys] : tableLocalData.itemRule.subLocalKey) {
-                    SubKeyTypeProcess()
-                    if (isFailed) break;
+                pendingRows.push_back(std::move(row));
+                if (!rulesParsed) return true;
+                if (tableLocalData) {
+                    typeState = DetectKeyTypes(pendingRows.back(), *tableLocalData);
                 }
-                if (!isFailed) break;
-            NextLoop:
-                ;
+                else {
+                    TryBuildRule(pendingRows.back());
+                }
+                FlushPendingRows();
+                return typeState != KeyTypeState::Failed;
             }
 
-            if (isFailed) return false;
+            std::unique_ptr<TableLocalData> Finish() {
+                if (!hasRules) return nullptr;
+                if (rulesFailed || !hasDataArray || !tableLocalData) {
+                    Log::ErrorFmt("GetItemRule failed: %s", tableName.c_str());
+                    return nullptr;
+                }
+                if (typeState == KeyTypeState::Failed) {
+                    Log::ErrorFmt("GetTableLocalData failed: %s", tableName.c_str());
+                    return nullptr;
+                }
+                // 所有行都需要继续判断类型时，仍按已有的类型构造
+                for (auto& row : pendingRows) {
+                    AddRow(row);
+                }
+                std::vector<nlohmann::json>().swap(pendingRows);
+                if (!hasSuccess) {
+                    Log::ErrorFmt("BuildUniqueKeyValue failed.");
+                    Log::ErrorFmt("GetTableLocalData failed: %s", tableName.c_str());
+                    return nullptr;
+                }
 
-            bool hasSuccess = false;
-            // 然后构造 transData
-            for (auto& data : fullData["data"]) {
-                if (!data.is_object()) continue;
-                if (BuildUniqueKeyValue(data, tableLocalData)) {
+                tableLocalData->transData.ShrinkToFit();
+                tableLocalData->transStrListData.ShrinkToFit();
+                // JVT_ArrayString in HelpCategory, ProduceStory, Tutorial
+                return std::move(tableLocalData);
+            }
+
+        private:
+            // 规则由第一条能推断出译文字段的行决定，类型仍从 data 的第一行开始判断
+            void TryBuildRule(nlohmann::json& row) {
+                if (tableLocalData || !BuildRowLocalRule(row, itemRule)) return;
+                tableLocalData = std::make_unique<TableLocalData>(TableLocalData{ .itemRule = std::move(itemRule) });
+                InternFieldPaths(*tableLocalData);
+                for (auto& pending : pendingRows) {
+                    if (typeState != KeyTypeState::NeedMore) break;
+                    typeState = DetectKeyTypes(pending, *tableLocalData);
+                }
+            }
+
+            void FlushPendingRows() {
+                if (typeState != KeyTypeState::Done) return;
+                for (auto& row : pendingRows) {
+                    AddRow(row);
+                }
+                std::vector<nlohmann::json>().swap(pendingRows);
+            }
+
+            void AddRow(nlohmann::json& row) {
+                if (BuildUniqueKeyValue(row, *tableLocalData, primaryKeyChecks)) {
                     hasSuccess = true;
                 }
             }
-            if (!hasSuccess) {
-                Log::ErrorFmt("BuildUniqueKeyValue failed.");
+
+            const std::string& tableName;
+            ItemRule itemRule{};
+            std::unique_ptr<TableLocalData> tableLocalData{};
+            std::vector<nlohmann::json> pendingRows{};
+            std::unordered_map<uint64_t, uint64_t> primaryKeyChecks{};
+            KeyTypeState typeState = KeyTypeState::NeedMore;
+            bool hasRules = false;
+            bool rulesParsed = false;
+            bool rulesFailed = false;
+            bool hasDataArray = false;
+            bool hasSuccess = false;
+        };
+
+        // 流式读取 rules/data 文件：只为 rules 和 data 中的每一行构造 json，
+        // 每行处理完即释放，不读入整个文件也不构造整张表的 json
+        class MasterTableReader : public nlohmann::json_sax<nlohmann::json> {
+        public:
+            explicit MasterTableReader(TableBuilder& builder) : builder(builder) {}
+
+            std::string error{};
+
+            bool null() override { return !value || value->null(); }
+            bool boolean(bool val) override { return !value || value->boolean(val); }
+            bool number_integer(number_integer_t val) override { return !value || value->number_integer(val); }
+            bool number_unsigned(number_unsigned_t val) override { return !value || value->number_unsigned(val); }
+            bool number_float(number_float_t val, const string_t& s) override { return !value || value->number_float(val, s); }
+            bool string(string_t& val) override { return !value || value->string(val); }
+            bool binary(binary_t& val) override { return !value || value->binary(val); }
+
+            bool key(string_t& val) override {
+                if (value) return value->key(val);
+                if (depth == 1) topKey = val;
+                return true;
+            }
+
+            bool start_object(std::size_t len) override {
+                if (!value && !BeginValue()) {
+                    depth++;
+                    return true;
+                }
+                depth++;
+                valueDepth++;
+                return value->start_object(len);
+            }
+
+            bool start_array(std::size_t len) override {
+                if (!value && !BeginValue()) {
+                    // 顶层必须是对象
+                    if (depth == 0) return false;
+                    if (depth == 1 && topKey == "data") {
+                        inDataArray = true;
+                        builder.OnDataArray();
+                    }
+                    depth++;
+                    return true;
+                }
+                depth++;
+                valueDepth++;
+                return value->start_array(len);
+            }
+
+            bool end_object() override {
+                depth--;
+                return !value || EndValue(value->end_object());
+            }
+
+            bool end_array() override {
+                depth--;
+                if (value) return EndValue(value->end_array());
+                if (depth == 1) inDataArray = false;
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+                error = ex.what();
+                return false;
+            }
+
+        private:
+            // 当前位置是 rules 的值或 data 中的一行时开始构造 json
+            bool BeginValue() {
+                isRules = depth == 1 && topKey == "rules";
+                if (!isRules && !(depth == 2 && inDataArray)) return false;
+                current = nullptr;
+                value.emplace(current);
+                return true;
+            }
+
+            bool EndValue(bool ok) {
+                if (!ok) return false;
+                if (--valueDepth > 0) return true;
+                value.reset();
+                if (isRules) {
+                    builder.OnRules(current);
+                    return true;
+                }
+                return builder.OnRow(current);
+            }
+
+            TableBuilder& builder;
+            std::optional<nlohmann::detail::json_sax_dom_parser<nlohmann::json>> value{};
+            nlohmann::json current{};
+            std::string topKey{};
+            int depth = 0;
+            int valueDepth = 0;
+            bool inDataArray = false;
+            bool isRules = false;
+        };
+
+        std::unique_ptr<TableLocalData> LoadTableFile(const std::string& tableName, const std::filesystem::path& path) {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs) return nullptr;
+            try {
+                TableBuilder builder(tableName);
+                MasterTableReader reader(builder);
+                if (nlohmann::json::sax_parse(ifs, &reader)) {
+                    return builder.Finish();
+                }
+                if (!reader.error.empty()) {
+                    Log::ErrorFmt("MasterLocal: load error in '%s': %s", path.string().c_str(), reader.error.c_str());
+                }
+                else {
+                    Log::ErrorFmt("GetTableLocalData failed: %s", tableName.c_str());
+                }
+            } catch (std::exception& e) {
+                Log::ErrorFmt("MasterLocal: load error in '%s': %s", path.string().c_str(), e.what());
+            }
+            return nullptr;
+        }
+
+        // 只关心顶层有没有 rules 键：找到即停止；第一个顶层键既不是 rules 也不是 data 时
+        // 是普通的 key-value 文件，同样立即停止。不构造任何 json 值
+        class TableHeaderReader : public nlohmann::json_sax<nlohmann::json> {
+        public:
+            bool hasRules = false;
+
+            bool null() override { return true; }
+            bool boolean(bool) override { return true; }
+            bool number_integer(number_integer_t) override { return true; }
+            bool number_unsigned(number_unsigned_t) override { return true; }
+            bool number_float(number_float_t, const string_t&) override { return true; }
+            bool string(string_t&) override { return true; }
+            bool binary(binary_t&) override { return true; }
+            bool start_object(std::size_t) override { depth++; return true; }
+            bool end_object() override { depth--; return true; }
+            // 顶层是数组时不是表
+            bool start_array(std::size_t) override { return depth++ > 0; }
+            bool end_array() override { depth--; return true; }
+
+            bool key(string_t& val) override {
+                if (depth != 1) return true;
+                if (val == "rules") {
+                    hasRules = true;
+                    return false;
+                }
+                return val == "data";
+            }
+
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+                return false;
+            }
+
+        private:
+            int depth = 0;
+        };
+
+        // 每张表只会加载一次。合并后的集合替换旧集合，旧集合等 IsTranslatedText 的读者离开后释放；
+        // 调用方不能处于 translatedTextReaders 的读区间内
+        void AddLoadedTable(MasterTableRegistry& registry, const TableLocalData* table) {
+            std::lock_guard lock(registry.translatedTextMutex);
+            auto merged = std::make_unique<Local::FingerprintSet>(
+                    registry.translatedTextOwner ? registry.translatedTextOwner->Clone() : Local::FingerprintSet{});
+            for (const auto& i : table->transData) {
+                merged->Insert(i.value);
+            }
+            for (const auto& i : table->transStrListData) {
+                for (const auto str : i.value) {
+                    merged->Insert(str);
+                }
+            }
+            merged->ShrinkToFit();
+            Log::InfoFmt("%zu master translated text fingerprints loaded (%zu bytes, %zu collisions).",
+                         merged->size(), merged->MemoryBytes(), merged->CollisionCount());
+
+            registry.translatedText.store(merged.get(), std::memory_order_release);
+            auto oldSet = std::exchange(registry.translatedTextOwner, std::move(merged));
+            if (oldSet) {
+                translatedTextReaders.Synchronize();
+                oldSet.reset();
+            }
+        }
+
+        void PrefetchTables(std::shared_ptr<MasterTableRegistry> registry, std::vector<std::string> tableNames) {
+            std::thread([registry = std::move(registry), tableNames = std::move(tableNames)]() {
+                const auto start = std::chrono::steady_clock::now();
+                size_t count = 0;
+                for (const auto& tableName : tableNames) {
+                    if (registry->retired.load(std::memory_order_acquire)) return;
+                    const auto entry = registry->tables.Find(tableName);
+                    if (!entry) continue;
+                    bool loadedNow = false;
+                    if (const auto table = (*entry)->Get(&loadedNow)) {
+                        if (loadedNow) AddLoadedTable(*registry, table);
+                        count++;
+                    }
+                }
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+                Log::InfoFmt("MasterLocal: %zu tables prefetched in %lld ms.", count, static_cast<long long>(elapsed.count()));
+            }).detach();
+        }
+
+        void RecordUsedTable(MasterTableRegistry& registry, const std::string& tableName) {
+            std::lock_guard lock(registry.usedTablesMutex);
+            if (!registry.usedTables.insert(tableName).second) return;
+            std::ofstream ofs(registry.prefetchFile, std::ios::app);
+            if (ofs) ofs << tableName << '\n';
+        }
+
+        // 预加载线程各自持有 shared_ptr，钩子线程通过 registryReaders 保证使用期间不被释放
+        std::shared_ptr<MasterTableRegistry> currentRegistryOwner{};
+        std::mutex registerMutex;
+
+        void RegisterTables(const std::vector<std::filesystem::path>& files) {
+            std::lock_guard registerLock(registerMutex);
+            auto registry = std::make_shared<MasterTableRegistry>();
+            const auto masterDir = Local::GetBasePath() / "local-files" / Config::localeCode / "masterTrans";
+            // 放在 masterTrans 目录外，不影响翻译文件的变化检测
+            registry->prefetchFile = masterDir.parent_path() / "masterTrans.prefetch";
+
+            std::vector<char> isTable(files.size());
+            Local::ParallelFor(files.size(), [&](size_t i) {
+                isTable[i] = IsMasterTableFile(files[i]);
+            });
+            for (size_t i = 0; i < files.size(); i++) {
+                if (!isTable[i]) continue;
+                auto tableName = files[i].stem().string();
+                registry->tables.Emplace(tableName, std::make_unique<MasterTableEntry>(tableName, files[i]));
+            }
+
+            std::vector<std::string> prefetchTables;
+            if (std::ifstream ifs(registry->prefetchFile); ifs) {
+                for (std::string line; std::getline(ifs, line);) {
+                    if (line.empty() || !registry->usedTables.insert(line).second) continue;
+                    if (registry->tables.Contains(line)) prefetchTables.push_back(line);
+                }
+            }
+
+            auto oldRegistry = std::exchange(currentRegistryOwner, registry);
+            currentRegistry.store(registry.get(), std::memory_order_release);
+            masterDataGeneration.fetch_add(1, std::memory_order_release);
+            if (oldRegistry) {
+                oldRegistry->retired.store(true, std::memory_order_release);
+                registryReaders.Synchronize();
+                oldRegistry.reset();
+            }
+            Log::InfoFmt("MasterLocal: %zu master tables registered, %zu to prefetch.", registry->tables.size(), prefetchTables.size());
+
+            if (!prefetchTables.empty()) {
+                PrefetchTables(std::move(registry), std::move(prefetchTables));
             }
-            return hasSuccess;
         }
 
         void LoadData() {
-            masterLocalData.clear();
             static auto masterDir = Local::GetBasePath() / "local-files" / Config::localeCode / "masterTrans";
             if (!std::filesystem::is_directory(masterDir)) {
                 Log::ErrorFmt("LoadData: not found: %s", masterDir.string().c_str());
                 return;
             }
 
-            bool isFirstIteration = true;
+            std::vector<std::filesystem::path> files;
             for (auto& p : std::filesystem::directory_iterator(masterDir)) {
-                if (isFirstIteration) {
-                    auto totalFileCount = std::distance(
-                            std::filesystem::directory_iterator(masterDir),
-                            std::filesystem::directory_iterator{}
-                    );
-                    UnityResolveProgress::classProgress.total = totalFileCount <= 0 ? 1 : totalFileCount;
-                    isFirstIteration = false;
-                }
-                UnityResolveProgress::classProgress.current++;
-
                 if (!p.is_regular_file()) continue;
-                const auto& path = p.path();
-                if (path.extension() != ".json") continue;
+                if (p.path().extension() != ".json") continue;
+                files.push_back(p.path());
+            }
+            UnityResolveProgress::classProgress.total = files.empty() ? 1 : static_cast<long>(files.size());
+            UnityResolveProgress::classProgress.current = UnityResolveProgress::classProgress.total;
+            RegisterTables(files);
+        }
+    }
 
-                std::string tableName = path.stem().string();
-                auto fileContent = ReadFileToString(path);
-                if (fileContent.empty()) continue;
+    const TableLocalData* MasterTableEntry::Get(bool* loadedNow) {
+        if (const auto table = loaded.load(std::memory_order_acquire)) return table;
+        if (failed.load(std::memory_order_acquire)) return nullptr;
+        std::lock_guard lock(loadMutex);
+        if (const auto table = loaded.load(std::memory_order_relaxed)) return table;
+        if (failed.load(std::memory_order_relaxed)) return nullptr;
+
+        const auto start = std::chrono::steady_clock::now();
+        data = Load::LoadTableFile(tableName, path);
+        if (!data) {
+            failed.store(true, std::memory_order_release);
+            return nullptr;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        Log::DebugFmt("MasterLocal: table %s loaded (%zu items) in %lld ms.", tableName.c_str(),
+                      data->transData.size() + data->transStrListData.size(), static_cast<long long>(elapsed.count()));
+        loaded.store(data.get(), std::memory_order_release);
+        if (loadedNow) *loadedNow = true;
+        return data.get();
+    }
 
-                try {
-                    auto j = nlohmann::json::parse(fileContent);
-                    if (!j.contains("rules") || !j["rules"].contains("primaryKeys")) {
-                        continue;
-                    }
-                    ItemRule currRule;
-                    if (!GetItemRule(j, currRule)) {
-                        Log::ErrorFmt("GetItemRule failed: %s", path.string().c_str());
-                        continue;
-                    }
+    bool IsMasterTableFile(const std::filesystem::path& path) {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs) return false;
+        Load::TableHeaderReader reader;
+        nlohmann::json::sax_parse(ifs, &reader);
+        return reader.hasRules;
+    }
 
-                    /*
-                    if (tableName == "ProduceStepEventDetail") {
-                        for (auto& i : currRule.mainLocalKey) {
-                            Log::DebugFmt("currRule.mainLocalKey: %s", i.c_str());
-                        }
-                        for (auto& i : currRule.mainPrimaryKey) {
-                            Log::DebugFmt("currRule.mainPrimaryKey: %s", i.c_str());
-                        }
-                        for (auto& i : currRule.subLocalKey) {
-                            for (auto& m : i.second) {
-                                Log::DebugFmt("currRule.subLocalKey: %s - %s", i.first.c_str(), m.c_str());
-                            }
-                        }
-                        for (auto& i : currRule.subPrimaryKey) {
-                            for (auto& m : i.second) {
-                                Log::DebugFmt("currRule.subPrimaryKey: %s - %s", i.first.c_str(), m.c_str());
-                            }
-                        }
-                    }*/
+    void LoadData() {
+        return Load::LoadData();
+    }
 
-                    TableLocalData tableLocalData{ .itemRule = currRule };
-                    if (GetTableLocalData(j, tableLocalData)) {
-                        for (auto& i : tableLocalData.transData) {
-                            // Log::DebugFmt("%s: %s -> %s", tableName.c_str(), i.first.c_str(), i.second.c_str());
-                            Local::translatedText.emplace(i.second);
-                        }
-                        for (auto& i : tableLocalData.transStrListData) {
-                            for (auto& str : i.second) {
-                                // Log::DebugFmt("%s[]: %s -> %s", tableName.c_str(), i.first.c_str(), str.c_str());
-                                Local::translatedText.emplace(str);
-                            }
-                        }
+    void RegisterTables(const std::vector<std::filesystem::path>& files) {
+        return Load::RegisterTables(files);
+    }
 
-                        /*
-                        if (tableName == "ProduceStepEventDetail") {
-                            for (auto& i : tableLocalData.mainKeyType) {
-                                Log::DebugFmt("mainKeyType: %s -> %d", i.first.c_str(), i.second);
-                            }
-                            for (auto& i : tableLocalData.subKeyType) {
-                                for (auto& m : i.second) {
-                                    Log::DebugFmt("subKeyType: %s - %s -> %d", i.first.c_str(), m.first.c_str(), m.second);
-                                }
-                            }
-                        }*/
-                        // JVT_ArrayString in HelpCategory, ProduceStory, Tutorial
+    // 不加锁：合并后的指纹集合发布后只读，查询一次探测
+    bool IsTranslatedText(std::string_view text) {
+        const auto readGuard = registryReaders.Enter();
+        const auto registry = currentRegistry.load(std::memory_order_acquire);
+        if (!registry) return false;
+        const auto textGuard = translatedTextReaders.Enter();
+        const auto translatedText = registry->translatedText.load(std::memory_order_acquire);
+        return translatedText && translatedText->Contains(text);
+    }
 
-                        masterLocalData.emplace(tableName, std::move(tableLocalData));
-                    }
-                    else {
-                        Log::ErrorFmt("GetTableLocalData failed: %s", path.string().c_str());
-                    }
-                } catch (std::exception& e) {
-                    Log::ErrorFmt("MasterLocal::LoadData: parse error in '%s': %s",
-                                  path.string().c_str(), e.what());
-                }
+    // 查询时才加载表，第一次加载的表记入预加载列表。须在 registryReaders 的读区间内调用，
+    // 返回的指针只在读区间内有效
+    const TableLocalData* GetTableData(const std::string& tableName) {
+        const auto registry = currentRegistry.load(std::memory_order_acquire);
+        if (!registry) return nullptr;
+        const auto entry = registry->tables.Find(tableName);
+        if (!entry) return nullptr;
+        bool loadedNow = false;
+        const auto table = (*entry)->Get(&loadedNow);
+        if (loadedNow) {
+            Load::AddLoadedTable(*registry, table);
+            Load::RecordUsedTable(*registry, tableName);
+        }
+        return table;
+    }
+
+    std::string_view GetTransString(const Local::MasterKey& key, const TableLocalData& localData) {
+        if (const auto value = localData.transData.Find(key)) {
+            return *value;
+        }
+        return {};
+    }
+
+    const std::vector<std::string_view>* GetTransArrayString(const Local::MasterKey& key, const TableLocalData& localData) {
+        const auto value = localData.transStrListData.Find(key);
+        return value && !value->empty() ? value : nullptr;
+    }
+
+    // 规则中的一个本地化字段
+    struct LocalKeyRule {
+        std::string name;  // name
+        JsonValueType type;
+        uint32_t pathId;
+    };
+
+    // 一个需要本地化的字段：路径编号、值类型和已解析的访问方式
+    struct LocalFieldPlan {
+        uint32_t pathId;
+        JsonValueType type;
+        FieldAccessor accessor;
+    };
+
+    // 某个 il2cpp 类上需要本地化的一组字段
+    struct ObjectPlan {
+        Il2cppUtils::Il2CppClassHead* klass = nullptr;
+        std::vector<LocalFieldPlan> fields{};
+    };
+
+    struct PrimaryKeyPlan {
+        JsonValueType type;
+        FieldAccessor accessor;
+    };
+
+    // List<T> 的 get_Count / get_Item
+    struct ListAccessor {
+        Il2cppUtils::Il2CppClassHead* klass = nullptr;
+        Il2cppUtils::MethodInfo* getCount = nullptr;
+        Il2cppUtils::MethodInfo* getItem = nullptr;
+        // get_Item 声明的返回类型
+        Il2cppUtils::Il2CppClassHead* itemClass = nullptr;
+
+        static ListAccessor Resolve(Il2cppUtils::Il2CppClassHead* klass) {
+            ListAccessor ret{ .klass = klass };
+            // 接口上的方法没有实现，只能在执行时按实际的列表类解析
+            if (!klass || UnityResolve::Invoke<bool>("il2cpp_class_is_interface", klass)) return ret;
+            ret.getCount = Il2cppUtils::il2cpp_class_get_method_from_name(klass, "get_Count", 0);
+            ret.getItem = Il2cppUtils::il2cpp_class_get_method_from_name(klass, "get_Item", 1);
+            if (ret.getItem) {
+                ret.itemClass = UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>(
+                        "il2cpp_class_from_type",
+                        UnityResolve::Invoke<void*>("il2cpp_method_get_return_type", ret.getItem)
+                );
             }
+            return ret;
         }
+    };
+
+    struct SubObjectPlan {
+        JsonValueType type;
+        FieldAccessor parentAccessor;
+        // 子对象中需要本地化的字段
+        std::vector<LocalKeyRule> localKeys{};
+        // 按声明类型在编译计划时一并编译，执行时只读不写
+        ListAccessor list{};
+        ObjectPlan itemPlan{};
+    };
+
+    // 按 (il2cpp 类, 表) 编译一次的本地化计划，执行时只计算主键哈希，不拼接查询 key、不查方法缓存
+    struct MasterItemPlan {
+        Il2cppUtils::Il2CppClassHead* klass = nullptr;
+        const TableLocalData* localData = nullptr;
+        std::vector<PrimaryKeyPlan> primaryKeys{};
+        ObjectPlan main{};
+        std::vector<SubObjectPlan> subs{};
+    };
+
+    // 主键字段的值，在调用线程读出。字符串和枚举名转成 UTF-8 放在共享的缓冲区中，工作线程不访问托管内存
+    struct PrimaryKeyValue {
+        int number = 0;
+        uint32_t textBegin = 0;
+        uint32_t textLength = 0;
+    };
+
+    // 查表得到的一个字段的译文，写回前保存
+    struct ResolvedField {
+        std::string_view text{};
+        const std::vector<std::string_view>* list = nullptr;
+    };
+
+    ObjectPlan CompileObjectPlan(Il2cppUtils::Il2CppClassHead* klass, const std::vector<LocalKeyRule>& localKeys) {
+        ObjectPlan plan{ .klass = klass };
+        for (const auto& [key, type, pathId] : localKeys) {
+            if (type != JsonValueType::JVT_String && type != JsonValueType::JVT_ArrayString) continue;
+            plan.fields.push_back({ .pathId = pathId, .type = type, .accessor = FieldAccessor::Resolve(klass, key) });
+        }
+        return plan;
     }
 
-    void LoadData() {
-        return Load::LoadData();
+    std::unique_ptr<MasterItemPlan> CompileMasterItemPlan(Il2cppUtils::Il2CppClassHead* klass, const TableLocalData& localData) {
+        auto plan = std::make_unique<MasterItemPlan>();
+        plan->klass = klass;
+        plan->localData = &localData;
+
+        for (const auto& mainPk : localData.itemRule.mainPrimaryKey) {
+            const auto type = localData.GetMainKeyType(mainPk);
+            if (type != JsonValueType::JVT_Int && type != JsonValueType::JVT_String) continue;
+            plan->primaryKeys.push_back({ .type = type, .accessor = FieldAccessor::Resolve(klass, mainPk) });
+        }
+
+        std::vector<LocalKeyRule> mainLocalKeys;
+        for (size_t i = 0; i < localData.itemRule.mainLocalKey.size(); i++) {
+            const auto& mainLocal = localData.itemRule.mainLocalKey[i];
+            mainLocalKeys.push_back({ mainLocal, localData.GetMainKeyType(mainLocal), localData.mainLocalPathIds[i] });
+        }
+        plan->main = CompileObjectPlan(klass, mainLocalKeys);
+
+        for (const auto& [subParentKey, subLocalKeys] : localData.itemRule.subLocalKey) {
+            const auto type = localData.GetMainKeyType(subParentKey);
+            if (type != JsonValueType::JVT_Object && type != JsonValueType::JVT_ArrayObject) continue;
+            const auto& pathIds = localData.subLocalPathIds.at(subParentKey);
+            auto& sub = plan->subs.emplace_back(SubObjectPlan{
+                    .type = type,
+                    .parentAccessor = FieldAccessor::Resolve(klass, subParentKey),
+            });
+            for (size_t i = 0; i < subLocalKeys.size(); i++) {
+                sub.localKeys.push_back({ subLocalKeys[i], localData.GetSubKeyType(subParentKey, subLocalKeys[i]), pathIds[i] });
+            }
+            auto itemClass = sub.parentAccessor.valueClass;
+            if (type == JsonValueType::JVT_ArrayObject) {
+                sub.list = ListAccessor::Resolve(itemClass);
+                itemClass = sub.list.itemClass;
+            }
+            if (itemClass) sub.itemPlan = CompileObjectPlan(itemClass, sub.localKeys);
+        }
+        return plan;
     }
 
-    std::string GetTransString(const std::string& key, const TableLocalData& localData) {
-        if (auto it = localData.transData.find(key); it != localData.transData.end()) {
-            return it->second;
+    // 每个线程各自缓存编译好的计划，编译和查找都不需要加锁；表重新登记后整体丢弃
+    struct MasterItemPlanCache {
+        std::unordered_map<Il2cppUtils::Il2CppClassHead*, std::vector<std::unique_ptr<const MasterItemPlan>>> plans{};
+        uint64_t generation = 0;
+    };
+
+    const MasterItemPlan* GetMasterItemPlan(Il2cppUtils::Il2CppClassHead* klass, const TableLocalData& localData) {
+        thread_local MasterItemPlanCache cache;
+        if (const auto generation = masterDataGeneration.load(std::memory_order_acquire); generation != cache.generation) {
+            cache.plans.clear();
+            cache.generation = generation;
         }
-        return {};
+        auto& plans = cache.plans[klass];
+        for (const auto& plan : plans) {
+            if (plan->localData == &localData) return plan.get();
+        }
+        return plans.emplace_back(CompileMasterItemPlan(klass, localData)).get();
     }
 
-    std::vector<std::string> GetTransArrayString(const std::string& key, const TableLocalData& localData) {
-        if (auto it = localData.transStrListData.find(key); it != localData.transStrListData.end()) {
-            return it->second;
+    // 读取主键字段，values 的长度为 plan.primaryKeys.size()，文本追加到 keyText；
+    // 字符串主键为空或不是合法的 UTF-16 时返回 false
+    bool ReadPrimaryKeys(const MasterItemPlan& plan, void* item, PrimaryKeyValue* values, std::string& keyText) {
+        for (size_t i = 0; i < plan.primaryKeys.size(); i++) {
+            const auto& pk = plan.primaryKeys[i];
+            auto& value = values[i];
+            if (pk.type == JsonValueType::JVT_Int) {
+                value.number = pk.accessor.Read<int>(item);
+                continue;
+            }
+            const auto begin = keyText.size();
+            if (pk.accessor.isEnum) {
+                const auto enumName = pk.accessor.EnumName(pk.accessor.Read<int>(item));
+                if (enumName.empty()) return false;
+                keyText.append(enumName);
+            }
+            else {
+                const auto str = pk.accessor.Read<Il2cppString*>(item);
+                if (!str) return false;
+                keyText.resize(begin + Utf::Utf8BufferSize(str->length));
+                const auto written = Utf::Utf16ToUtf8(str->chars, str->length, keyText.data() + begin);
+                if (written == Utf::kInvalid) {
+                    keyText.resize(begin);
+                    return false;
+                }
+                keyText.resize(begin + written);
+            }
+            value.textBegin = static_cast<uint32_t>(begin);
+            value.textLength = static_cast<uint32_t>(keyText.size() - begin);
         }
-        return {};
+        return true;
     }
 
-    void LocalizeMasterItem(FieldController& fc, const std::string& tableName) {
-        auto it = masterLocalData.find(tableName);
-        if (it == masterLocalData.end()) return;
-        const auto& localData = it->second;
-
-        // 首先拼 BasePrimaryKey
-        std::string baseDataKey;  // p_card-00-acc-0_002|0|
-        for (auto& mainPk : localData.itemRule.mainPrimaryKey) {
-            auto mainPkType = localData.GetMainKeyType(mainPk);
-            switch (mainPkType) {
-                case JsonValueType::JVT_Int: {
-                    auto readValue = std::to_string(fc.ReadIntField(mainPk));
-                    baseDataKey.append(readValue);
-                    baseDataKey.push_back('|');
-                } break;
-                case JsonValueType::JVT_String: {
-                    auto readValue = fc.ReadStringField(mainPk);
-                    if (!readValue) return;
-                    baseDataKey.append(readValue->ToString());
-                    baseDataKey.push_back('|');
-                } break;
-                default:
-                    break;
+    // 只读取 ReadPrimaryKeys 得到的本地数据，可以在工作线程执行
+    uint64_t HashPrimaryKeys(const MasterItemPlan& plan, const PrimaryKeyValue* values, std::string_view keyText) {
+        uint64_t primaryKeyHash = 0;
+        for (size_t i = 0; i < plan.primaryKeys.size(); i++) {
+            const auto& value = values[i];
+            if (plan.primaryKeys[i].type == JsonValueType::JVT_Int) {
+                primaryKeyHash = Local::MixPrimaryKeyPart(primaryKeyHash, value.number);
+            }
+            else {
+                primaryKeyHash = Local::MixPrimaryKeyPart(primaryKeyHash, keyText.substr(value.textBegin, value.textLength));
             }
         }
+        return primaryKeyHash;
+    }
 
-        // 然后本地化 mainLocal
-        for (auto& mainLocal : localData.itemRule.mainLocalKey) {
-            std::string currSearchKey = baseDataKey;
-            currSearchKey.append(mainLocal);  // p_card-00-acc-0_002|0|name
-            auto localVType = localData.GetMainKeyType(mainLocal);
-            switch (localVType) {
-                case JsonValueType::JVT_String: {
-                    auto localValue = GetTransString(currSearchKey, localData);
-                    if (!localValue.empty()) {
-                        fc.SetStringField(mainLocal, localValue);
-                    }
-                } break;
-                case JsonValueType::JVT_ArrayString: {
-                    auto localValue = GetTransArrayString(currSearchKey, localData);
-                    if (!localValue.empty()) {
-                        fc.SetStringListField(mainLocal, localValue);
-                    }
-                } break;
-                default:
-                    break;
+    ResolvedField ResolveField(const LocalFieldPlan& field, const TableLocalData& localData, const Local::MasterKey& key) {
+        if (field.type == JsonValueType::JVT_String) {
+            return { .text = GetTransString(key, localData) };
+        }
+        return { .list = GetTransArrayString(key, localData) };
+    }
+
+    void WriteResolvedField(const LocalFieldPlan& field, void* self, const ResolvedField& resolved) {
+        if (!resolved.text.empty()) {
+            field.accessor.Write(self, Local::GetManagedString(resolved.text));
+        }
+        else if (resolved.list) {
+            field.accessor.Write(self, NewManagedStringList(*resolved.list));
+        }
+    }
+
+    void ApplyObjectPlan(const ObjectPlan& plan, void* self, const TableLocalData& localData, Local::MasterKey key) {
+        for (const auto& field : plan.fields) {
+            key.pathId = field.pathId;
+            WriteResolvedField(field, self, ResolveField(field, localData, key));
+        }
+    }
+
+    // 子对象的实际类与声明类型不同（派生类、接口）时，在本次调用内临时编译，不修改共享的计划
+    const ObjectPlan& SelectItemPlan(const SubObjectPlan& sub, Il2cppUtils::Il2CppClassHead* klass, ObjectPlan& runtimePlan) {
+        if (sub.itemPlan.klass == klass) return sub.itemPlan;
+        if (runtimePlan.klass != klass) runtimePlan = CompileObjectPlan(klass, sub.localKeys);
+        return runtimePlan;
+    }
+
+    void ApplySubObjectPlan(const SubObjectPlan& sub, void* self, const TableLocalData& localData, uint64_t primaryKeyHash) {
+        const auto subObj = sub.parentAccessor.Read<void*>(self);
+        if (!subObj) return;
+
+        ObjectPlan runtimePlan{};
+        if (sub.type == JsonValueType::JVT_Object) {
+            const auto& itemPlan = SelectItemPlan(sub, Il2cppUtils::get_class_from_instance(subObj), runtimePlan);
+            ApplyObjectPlan(itemPlan, subObj, localData, { .primaryKeyHash = primaryKeyHash });
+            return;
+        }
+
+        const auto listClass = Il2cppUtils::get_class_from_instance(subObj);
+        const auto list = sub.list.klass == listClass ? sub.list : ListAccessor::Resolve(listClass);
+        if (!list.getCount || !list.getItem) return;
+        const auto count = reinterpret_cast<int (*)(void*, void*)>(list.getCount->methodPointer)(subObj, list.getCount);
+        const auto getItem = reinterpret_cast<void* (*)(void*, int, void*)>(list.getItem->methodPointer);
+        for (int idx = 0; idx < count; idx++) {
+            const auto currItem = getItem(subObj, idx, list.getItem);
+            if (!currItem) continue;
+            const auto& itemPlan = SelectItemPlan(sub, Il2cppUtils::get_class_from_instance(currItem), runtimePlan);
+            ApplyObjectPlan(itemPlan, currItem, localData, { .primaryKeyHash = primaryKeyHash, .arrayIndex = idx });
+        }
+    }
+
+    void ExecuteMasterItemPlan(const MasterItemPlan& plan, void* item) {
+        const auto& localData = *plan.localData;
+        thread_local std::vector<PrimaryKeyValue> keys;
+        thread_local std::string keyText;
+        keys.assign(plan.primaryKeys.size(), {});
+        keyText.clear();
+
+        // 首先计算主键哈希
+        if (!ReadPrimaryKeys(plan, item, keys.data(), keyText)) return;
+        const auto primaryKeyHash = HashPrimaryKeys(plan, keys.data(), keyText);
+
+        ApplyObjectPlan(plan.main, item, localData, { .primaryKeyHash = primaryKeyHash });
+        for (const auto& sub : plan.subs) {
+            ApplySubObjectPlan(sub, item, localData, primaryKeyHash);
+        }
+    }
+
+    void LocalizeMasterItem(void* item, const std::string& tableName) {
+        if (!item) return;
+        const auto readGuard = registryReaders.Enter();
+        const auto localData = GetTableData(tableName);
+        if (!localData) return;
+        ExecuteMasterItemPlan(*GetMasterItemPlan(Il2cppUtils::get_class_from_instance(item), *localData), item);
+    }
+
+    // 批量本地化中的一个对象，keys / fields 为在共享数组中的起始位置
+    struct BatchItem {
+        void* item;
+        const MasterItemPlan* plan;
+        size_t keyBegin;
+        size_t fieldBegin;
+        uint64_t primaryKeyHash = 0;
+    };
+
+    // 每个工作线程一次处理的对象数；对象较少时不启用工作线程
+    constexpr size_t kBatchChunkSize = 64;
+    constexpr size_t kMinParallelChunks = 4;
+
+    template <typename Fn>
+    void RunBatchChunks(size_t chunkCount, Fn&& fn) {
+        if (chunkCount < kMinParallelChunks) {
+            for (size_t chunk = 0; chunk < chunkCount; chunk++) fn(chunk);
+            return;
+        }
+        Local::WorkerPool::Instance().Run(chunkCount, fn);
+    }
+
+    // 在 registryReaders 的读区间内调用，objects 中的空指针会被跳过
+    void LocalizeMasterBatch(const std::vector<void*>& objects, const TableLocalData* localData) {
+        // 第一步（调用线程）：读取主键字段
+        std::vector<BatchItem> items;
+        std::vector<PrimaryKeyValue> keys;
+        std::string keyText;
+        std::vector<ResolvedField> fields;
+        items.reserve(objects.size());
+        Il2cppUtils::Il2CppClassHead* lastClass = nullptr;
+        const MasterItemPlan* plan = nullptr;
+        for (const auto item : objects) {
+            if (!item) continue;
+            if (const auto klass = Il2cppUtils::get_class_from_instance(item); klass != lastClass) {
+                lastClass = klass;
+                plan = GetMasterItemPlan(klass, *localData);
             }
+            const auto keyBegin = keys.size();
+            keys.resize(keyBegin + plan->primaryKeys.size());
+            if (!ReadPrimaryKeys(*plan, item, keys.data() + keyBegin, keyText)) {
+                keys.resize(keyBegin);
+                continue;
+            }
+            items.push_back({ .item = item, .plan = plan, .keyBegin = keyBegin, .fieldBegin = fields.size() });
+            fields.resize(fields.size() + plan->main.fields.size());
         }
 
-        // 处理 sub
-        for (const auto& [subParentKey, subLocalKeys] : localData.itemRule.subLocalKey) {
-            const auto subBaseSearchKey = baseDataKey + subParentKey + '|';  // p_card-00-acc-0_002|0|produceDescriptions|
-
-            const auto subParentType = localData.GetMainKeyType(subParentKey);
-            switch (subParentType) {
-                case JsonValueType::JVT_Object: {
-                    auto subParentField = fc.CreateSubFieldController(subParentKey);
-                    for (const auto& subLocalKey : subLocalKeys) {
-                        const auto currSearchKey = subBaseSearchKey + subLocalKey;  // p_card-00-acc-0_002|0|produceDescriptions|text
-                        auto localKeyType = localData.GetSubKeyType(subParentKey, subLocalKey);
-                        if (localKeyType == JsonValueType::JVT_String) {
-                            auto setData = GetTransString(currSearchKey, localData);
-                            if (!setData.empty()) {
-                                subParentField.SetStringField(subLocalKey, setData);
-                            }
-                        }
-                        else if (localKeyType == JsonValueType::JVT_ArrayString) {
-                            auto setData = GetTransArrayString(currSearchKey, localData);
-                            if (!setData.empty()) {
-                                subParentField.SetStringListField(subLocalKey, setData);
-                            }
-                        }
-                    }
-                } break;
-                case JsonValueType::JVT_ArrayObject: {
-                    auto subArrField = fc.ReadObjectListField(subParentKey);
-                    if (!subArrField) continue;
-                    Il2cppUtils::Tools::CSListEditor<void*> subListEdit(subArrField);
-                    auto count = subListEdit.get_Count();
-                    for (int idx = 0; idx < count; idx++) {
-                        auto currItem = subListEdit.get_Item(idx);
-                        if (!currItem) continue;
-                        auto currFc = FieldController::CreateSubFieldController(currItem);
-
-                        std::string currSearchBaseKey = subBaseSearchKey;  // p_card-00-acc-0_002|0|produceDescriptions|
-                        currSearchBaseKey.push_back('[');
-                        currSearchBaseKey.append(std::to_string(idx));
-                        currSearchBaseKey.append("]|");  // p_card-00-acc-0_002|0|produceDescriptions|[0]|
-
-                        for (const auto& subLocalKey : subLocalKeys) {
-                            std::string currSearchKey = currSearchBaseKey + subLocalKey;  // p_card-00-acc-0_002|0|produceDescriptions|[0]|text
-
-                            auto localKeyType = localData.GetSubKeyType(subParentKey, subLocalKey);
-
-                            /*
-                            if (tableName == "ProduceStepEventDetail") {
-                                Log::DebugFmt("localKeyType: %d currSearchKey: %s", localKeyType, currSearchKey.c_str());
-                            }*/
-
-                            if (localKeyType == JsonValueType::JVT_String) {
-                                auto setData = GetTransString(currSearchKey, localData);
-                                if (!setData.empty()) {
-                                    currFc.SetStringField(subLocalKey, setData);
-                                }
-                            }
-                            else if (localKeyType == JsonValueType::JVT_ArrayString) {
-                                auto setData = GetTransArrayString(currSearchKey, localData);
-                                if (!setData.empty()) {
-                                    currFc.SetStringListField(subLocalKey, setData);
-                                }
-                            }
-                        }
-                    }
+        // 第二步（工作线程）：计算主键哈希，查出主对象各字段的译文。只访问第一步得到的本地数据
+        const auto chunkCount = (items.size() + kBatchChunkSize - 1) / kBatchChunkSize;
+        RunBatchChunks(chunkCount, [&](size_t chunk) {
+            const auto end = std::min(items.size(), (chunk + 1) * kBatchChunkSize);
+            for (size_t i = chunk * kBatchChunkSize; i < end; i++) {
+                auto& batch = items[i];
+                batch.primaryKeyHash = HashPrimaryKeys(*batch.plan, keys.data() + batch.keyBegin, keyText);
+                Local::MasterKey key{ .primaryKeyHash = batch.primaryKeyHash };
+                const auto& planFields = batch.plan->main.fields;
+                for (size_t f = 0; f < planFields.size(); f++) {
+                    key.pathId = planFields[f].pathId;
+                    fields[batch.fieldBegin + f] = ResolveField(planFields[f], *localData, key);
+                }
+            }
+        });
 
-                } break;
-                default:
-                    break;
+        // 第三步（调用线程）：写回托管对象。子对象需要调用 getter 遍历，与写回一起完成
+        for (const auto& batch : items) {
+            const auto& planFields = batch.plan->main.fields;
+            for (size_t f = 0; f < planFields.size(); f++) {
+                WriteResolvedField(planFields[f], batch.item, fields[batch.fieldBegin + f]);
+            }
+            for (const auto& sub : batch.plan->subs) {
+                ApplySubObjectPlan(sub, batch.item, *localData, batch.primaryKeyHash);
             }
         }
+    }
 
+    void LocalizeMasterList(void* list, const std::string& tableName) {
+        if (!list) return;
+        const auto readGuard = registryReaders.Enter();
+        const auto localData = GetTableData(tableName);
+        if (!localData) return;
+
+        Il2cppUtils::Tools::CSListEditor<void*> listEditor(list);
+        const auto count = listEditor.get_Count();
+        if (count <= 0) return;
+        std::vector<void*> objects(count);
+        for (int i = 0; i < count; i++) {
+            objects[i] = listEditor.get_Item(i);
+        }
+        LocalizeMasterBatch(objects, localData);
     }
 
-//    void LocalizeMasterItem(void* item, const std::string& tableName) {
-//        if (!Config::useMasterTrans) return;
-//        // Log::DebugFmt("LocalizeMasterItem: %s", tableName.c_str());
-//        FieldController fc(item);
-//        LocalizeMasterItem(fc, tableName);
-//    }
+    void LocalizeMasterItems(const std::vector<void*>& items, const std::string& tableName) {
+        if (items.empty()) return;
+        const auto readGuard = registryReaders.Enter();
+        const auto localData = GetTableData(tableName);
+        if (!localData) return;
+        LocalizeMasterBatch(items, localData);
+    }
 
 } // namespace LinkuraLocal::MasterLocal
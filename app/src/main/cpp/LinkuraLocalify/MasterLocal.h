@@ -1,12 +1,29 @@
 #ifndef LINKURA_LOCALIFY_MASTERLOCAL_H
 #define LINKURA_LOCALIFY_MASTERLOCAL_H
 
+#include <filesystem>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace LinkuraLocal::MasterLocal {
+    // 只读取到顶层的 rules 键为止，判断是否为 rules/data 格式的 masterTrans 文件
+    bool IsMasterTableFile(const std::filesystem::path& path);
+
+    // 扫描 masterTrans 目录后登记其中的表
     void LoadData();
+    // 登记 rules/data 格式的 masterTrans 文件，表名为文件名。启动时只读取 rules 头部，
+    // 译文在第一次查询该表时才解析；上次会话用到过的表在后台线程预先加载
+    void RegisterTables(const std::vector<std::filesystem::path>& files);
+
+    // 已加载的表中是否有这条译文
+    bool IsTranslatedText(std::string_view text);
 
     void LocalizeMasterItem(void* item, const std::string& tableName);
+    // 一次处理整张表的 List<T>：主键哈希和查表在工作线程并行完成，写回托管对象在调用线程
+    void LocalizeMasterList(void* list, const std::string& tableName);
+    // 与 LocalizeMasterList 相同，对象由调用方给出
+    void LocalizeMasterItems(const std::vector<void*>& items, const std::string& tableName);
 }
 
 #endif //LINKURA_LOCALIFY_MASTERLOCAL_H
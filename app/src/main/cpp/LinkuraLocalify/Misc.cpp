@@ -1,7 +1,6 @@
 #include "Misc.hpp"
+#include "utf/Utf.hpp"
 
-#include <codecvt>
-#include <locale>
 #include "fmt/core.h"
 
 #include <stdexcept>
@@ -22,29 +21,24 @@ namespace LinkuraLocal::Misc {
     std::string ToUTF8(const std::wstring_view& str) {
 		return utility::conversions::to_utf8string(str.data());
     }
+#endif
 
+    // 非法输入时与原先的 wstring_convert 一样抛出 std::range_error
     std::u16string ToUTF16(const std::string_view& str) {
-        std::string input(str);
-        std::wstring wstr = utility::conversions::utf8_to_utf16(input);
-        return std::u16string(wstr.begin(), wstr.end());
-    }
-
-    std::string ToUTF8(const std::u16string_view& str) {
-        std::u16string u16(str);
-        std::wstring wstr(u16.begin(), u16.end());
-        return utility::conversions::utf16_to_utf8(wstr);
-    }
-#else
-    std::u16string ToUTF16(const std::string_view& str) {
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> utf16conv;
-        return utf16conv.from_bytes(str.data(), str.data() + str.size());
+        std::u16string ret;
+        if (!Utf::Utf8ToUtf16(str, &ret)) {
+            throw std::range_error("ToUTF16: invalid UTF-8");
+        }
+        return ret;
     }
 
     std::string ToUTF8(const std::u16string_view& str) {
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> utf16conv;
-        return utf16conv.to_bytes(str.data(), str.data() + str.size());
+        std::string ret;
+        if (!Utf::Utf16ToUtf8(str, &ret)) {
+            throw std::range_error("ToUTF8: invalid UTF-16");
+        }
+        return ret;
     }
-#endif
 
 #ifndef GKMS_WINDOWS
     JNIEnv* GetJNIEnv() {
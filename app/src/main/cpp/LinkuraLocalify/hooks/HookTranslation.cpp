@@ -4,17 +4,37 @@
 
 #include "../HookMain.h"
 #include "../Local.h"
-#include <re2/re2.h>
+#include "../MasterLocal.h"
+#include "../local/FontRegistry.hpp"
+#include "../local/ManagedStringCache.hpp"
+#include "../local/TextMemo.hpp"
+#include <array>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace LinkuraLocal::HookTranslation {
     using Il2cppString = UnityResolve::UnityType::String;
 
     void* fontCache = nullptr;
+    // 字体文件是否存在，fontCache 为空时每帧重新检查一次，启动后放入的字体也能生效
+    bool fontFileExists = false;
+    Local::FontAssetRegistry fontRegistry{};
+    // 每帧最多检查的字体资源记录数
+    constexpr size_t kFontSweepPerFrame = 8;
+
+    const std::filesystem::path& GetReplaceFontPath() {
+        static const auto fontName = Local::GetBasePath() / "local-files" / "gkamsZHFontMIX.otf";
+        return fontName;
+    }
+
     void* GetReplaceFont() {
-        static auto fontName = Local::GetBasePath() / "local-files" / "gkamsZHFontMIX.otf";
-        if (!std::filesystem::exists(fontName)) {
+        if (fontCache) return fontCache;
+        if (!fontFileExists) {
             return nullptr;
         }
+        const auto& fontName = GetReplaceFontPath();
 
         static auto CreateFontFromPath = reinterpret_cast<void (*)(void* self, Il2cppString* path)>(
                 Il2cppUtils::il2cpp_resolve_icall("UnityEngine.Font::Internal_CreateFontFromPath(UnityEngine.Font,System.String)")
@@ -23,22 +43,49 @@ namespace LinkuraLocal::HookTranslation {
                                                        "UnityEngine", "Font");
         static auto Font_ctor = Il2cppUtils::GetMethod("UnityEngine.TextRenderingModule.dll",
                                                        "UnityEngine", "Font", ".ctor");
-        if (fontCache) {
-            if (Il2cppUtils::IsNativeObjectAlive(fontCache)) {
-                return fontCache;
-            }
-        }
 
         const auto newFont = Font_klass->New<void*>();
         Font_ctor->Invoke<void>(newFont);
 
         CreateFontFromPath(newFont, Il2cppString::New(fontName.string()));
         fontCache = newFont;
+        // 之前替换过的字体资源引用的是旧字体，遇到时重新替换
+        fontRegistry.NewGeneration();
         return newFont;
     }
-    std::unordered_set<void*> updatedFontPtrs{};
+
+    // 每帧只检查一次替换字体是否存活，并顺带清理少量已销毁的字体资源记录
+    void CheckFontLiveness() {
+        static auto get_frameCount = reinterpret_cast<int (*)()>(
+                Il2cppUtils::il2cpp_resolve_icall("UnityEngine.Time::get_frameCount()"));
+        static int lastCheckedFrame = -1;
+        if (get_frameCount) {
+            const auto frame = get_frameCount();
+            if (frame == lastCheckedFrame) return;
+            lastCheckedFrame = frame;
+        }
+        if (fontCache && !Il2cppUtils::IsNativeObjectAlive(fontCache)) {
+            // 立即让所有已替换的字体资源失效，它们的 sourceFontFile 仍指向已销毁的字体
+            fontCache = nullptr;
+            fontRegistry.NewGeneration();
+        }
+        if (!fontCache) {
+            std::error_code ec;
+            fontFileExists = std::filesystem::exists(GetReplaceFontPath(), ec);
+        }
+        fontRegistry.Sweep(kFontSweepPerFrame, [](void* asset) {
+            return Il2cppUtils::IsNativeObjectAlive(asset);
+        });
+    }
+
+    std::u16string_view GetStringView(const Il2cppString* str) {
+        return {str->chars, static_cast<size_t>(str->length)};
+    }
+
     void UpdateTMPFont(void* TMP_Textself) {
         if (!Config::replaceFont || !TMP_Textself) return;
+        static auto TMP_Text_klass = Il2cppUtils::GetClass("Unity.TextMeshPro.dll", "TMPro", "TMP_Text");
+        static auto fontAsset_field = TMP_Text_klass->Get<UnityResolve::Field>("m_fontAsset");
         static auto get_font = Il2cppUtils::GetMethod("Unity.TextMeshPro.dll",
                                                       "TMPro", "TMP_Text", "get_font");
         static auto set_font = Il2cppUtils::GetMethod("Unity.TextMeshPro.dll",
@@ -56,21 +103,23 @@ namespace LinkuraLocal::HookTranslation {
         static auto UpdateFontAssetData = Il2cppUtils::GetMethod("Unity.TextMeshPro.dll", "TMPro",
                                                                  "TMP_FontAsset", "UpdateFontAssetData");
 
+        CheckFontLiveness();
+        // get_font 只返回 m_fontAsset，能直接读字段时不走反射调用
+        auto fontAsset = fontAsset_field ? Il2cppUtils::ClassGetFieldValue<void*>(TMP_Textself, fontAsset_field)
+                                         : get_font->Invoke<void*>(TMP_Textself);
+        // 该字体资源已替换过，整个字体流程都可以跳过
+        if (fontAsset && fontRegistry.IsPatched(fontAsset)) return;
+
         auto newFont = GetReplaceFont();
         if (!newFont) return;
-
-        auto fontAsset = get_font->Invoke<void*>(TMP_Textself);
-        if (fontAsset) {
-            set_sourceFontFile->Invoke<void>(fontAsset, newFont);
-            if (!updatedFontPtrs.contains(fontAsset)) {
-                updatedFontPtrs.emplace(fontAsset);
-                UpdateFontAssetData->Invoke<void>(fontAsset);
-            }
-            if (updatedFontPtrs.size() > 200) updatedFontPtrs.clear();
-        }
-        else {
+        if (!fontAsset) {
             Log::Error("UpdateFont: fontAsset is null.");
+            return;
         }
+
+        set_sourceFontFile->Invoke<void>(fontAsset, newFont);
+        UpdateFontAssetData->Invoke<void>(fontAsset);
+        fontRegistry.MarkPatched(fontAsset);
         set_font->Invoke<void>(TMP_Textself, fontAsset);
 
 //        auto fontMaterial = get_material->Invoke<void*>(fontAsset);
@@ -78,17 +127,49 @@ namespace LinkuraLocal::HookTranslation {
 //        ForceMeshUpdate->Invoke<void>(TMP_Textself, false, false);
     }
 
+    Local::TextMemo textMemo{2048};
+
+    // 是否可以对本次调用使用 textMemo：测试模式下每次都要输出日志，不做记录
+    bool UseTextMemo() {
+        return Config::enableLocale && !Config::textTest;
+    }
+
+    void LogTextMemoStats() {
+        if (!Config::dbgMode) return;
+        const auto lookups = textMemo.Hits() + textMemo.Misses();
+        if (lookups % 10000 != 0) return;
+        Log::DebugFmt("TMP_Text memo: %llu hits, %llu misses (%.1f%% hit rate), %llu evicted",
+                      static_cast<unsigned long long>(textMemo.Hits()), static_cast<unsigned long long>(textMemo.Misses()),
+                      textMemo.HitRate() * 100.0, static_cast<unsigned long long>(textMemo.Evictions()));
+    }
+
     DEFINE_HOOK(void, TMP_Text_PopulateTextBackingArray, (void* self, UnityResolve::UnityType::String* text, int start, int length)) {
         if (!text) return TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
+        const bool inRange = start >= 0 && length >= 0 && start <= text->length - length;
+        // 字体可能在文本不变时被替换或需要重新处理，命中 textMemo 也要先检查；已替换过时只是一次 IsPatched 查询
         UpdateTMPFont(self);
-        if (!Config::enableLocale) return TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
-        static auto Substring = Il2cppUtils::GetMethod("mscorlib.dll", "System", "String", "Substring",
-                                                       {"System.Int32", "System.Int32"});
+        Local::TextMemoKey memoKey{};
+        const bool useMemo = inRange && UseTextMemo();
+        if (useMemo) {
+            memoKey = Local::TextMemo::MakeKey(self, Local::TextHookKind::PopulateTextBackingArray, text, start, length, Local::GetDataGeneration());
+            Il2cppString* memoResult;
+            const bool hit = textMemo.Find(memoKey, &memoResult);
+            LogTextMemoStats();
+            if (hit) {
+                if (memoResult) return TMP_Text_PopulateTextBackingArray_Orig(self, memoResult, 0, memoResult->length);
+                return TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
+            }
+        }
+
+        if (!Config::enableLocale || !inRange) return TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
 
-        const std::string origText = Substring->Invoke<Il2cppString*>(text, start, length)->ToString();
+        const auto origText = GetStringView(text).substr(start, length);
         std::string transText;
         if (Local::GetGenericText(origText, &transText)) {
-            const auto newText = UnityResolve::UnityType::String::New(transText);
+            const auto newText = Local::GetManagedString(transText);
+            // 托管字符串创建失败时按原文显示
+            if (!newText) return TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
+            if (useMemo) textMemo.Store(memoKey, newText);
             return TMP_Text_PopulateTextBackingArray_Orig(self, newText, 0, newText->length);
         }
 
@@ -96,6 +177,7 @@ namespace LinkuraLocal::HookTranslation {
             Log::VerboseFmt("[TP] %s", text->ToString().c_str());
             TMP_Text_PopulateTextBackingArray_Orig(self, UnityResolve::UnityType::String::New("[TP]" + text->ToString()), start, length + 4);
         } else {
+            if (useMemo) textMemo.Store(memoKey, nullptr);
             TMP_Text_PopulateTextBackingArray_Orig(self, text, start, length);
         }
     }
@@ -103,11 +185,22 @@ namespace LinkuraLocal::HookTranslation {
     DEFINE_HOOK(void, TMP_Text_SetText_2, (void* self, Il2cppString* sourceText, bool syncTextInputBox, void* mtd)) {
         if (!sourceText) return TMP_Text_SetText_2_Orig(self, sourceText, syncTextInputBox, mtd);
         UpdateTMPFont(self);
+        Local::TextMemoKey memoKey{};
+        const bool useMemo = UseTextMemo();
+        if (useMemo) {
+            memoKey = Local::TextMemo::MakeKey(self, Local::TextHookKind::SetText, sourceText, 0, sourceText->length, Local::GetDataGeneration());
+            Il2cppString* memoResult;
+            const bool hit = textMemo.Find(memoKey, &memoResult);
+            LogTextMemoStats();
+            if (hit) return TMP_Text_SetText_2_Orig(self, memoResult ? memoResult : sourceText, syncTextInputBox, mtd);
+        }
+
         if (!Config::enableLocale) return TMP_Text_SetText_2_Orig(self, sourceText, syncTextInputBox, mtd);
-        const std::string origText = sourceText->ToString();
         std::string transText;
-        if (Local::GetGenericText(origText, &transText)) {
-            const auto newText = UnityResolve::UnityType::String::New(transText);
+        if (Local::GetGenericText(GetStringView(sourceText), &transText)) {
+            const auto newText = Local::GetManagedString(transText);
+            if (!newText) return TMP_Text_SetText_2_Orig(self, sourceText, syncTextInputBox, mtd);
+            if (useMemo) textMemo.Store(memoKey, newText);
 
             return TMP_Text_SetText_2_Orig(self, newText, syncTextInputBox, mtd);
         }
@@ -115,10 +208,22 @@ namespace LinkuraLocal::HookTranslation {
             Log::VerboseFmt("[TS] %s", sourceText->ToString().c_str());
             TMP_Text_SetText_2_Orig(self, UnityResolve::UnityType::String::New("[TS]" + sourceText->ToString()), syncTextInputBox, mtd);
         } else {
+            if (useMemo) textMemo.Store(memoKey, nullptr);
             TMP_Text_SetText_2_Orig(self, sourceText, syncTextInputBox, mtd);
         }
     }
 
+    // 组件销毁后清除 textMemo 中的记录，避免地址被新对象复用时重放旧结果
+    DEFINE_HOOK(void, TextMeshProUGUI_OnDestroy, (void* self, void* mtd)) {
+        textMemo.Evict(self);
+        TextMeshProUGUI_OnDestroy_Orig(self, mtd);
+    }
+
+    DEFINE_HOOK(void, TextMeshPro_OnDestroy, (void* self, void* mtd)) {
+        textMemo.Evict(self);
+        TextMeshPro_OnDestroy_Orig(self, mtd);
+    }
+
     DEFINE_HOOK(void, TextMeshProUGUI_Awake, (void* self, void* method)) {
         // Log::InfoFmt("TextMeshProUGUI_Awake at %p, self at %p", TextMeshProUGUI_Awake_Orig, self);
         UpdateTMPFont(self);
@@ -132,7 +237,7 @@ namespace LinkuraLocal::HookTranslation {
             //Log::InfoFmt("TextMeshProUGUI_Awake: %s", currText->ToString().c_str());
             std::string transText;
             if (Local::GetGenericText(currText->ToString(), &transText)) {
-                set_Text_method->Invoke<void>(self, UnityResolve::UnityType::String::New(transText));
+                set_Text_method->Invoke<void>(self, Local::GetManagedString(transText));
                 TextMeshProUGUI_Awake_Orig(self, method);
                 return;
             }
@@ -152,14 +257,12 @@ namespace LinkuraLocal::HookTranslation {
     DEFINE_HOOK(void, Text_set_text, (void* self, Il2cppString* sourceText, void* mtd)) {
         if (!sourceText) return Text_set_text_Orig(self, sourceText, mtd);
         if (!Config::enableLocale) return Text_set_text_Orig(self, sourceText, mtd);
-        // 特判时间
-        std::string origText = sourceText->ToString();
-        RE2 time(R"((\d{1,2}:\d{1,2})|\d+)");
-        if (RE2::FullMatch(origText, time)) return Text_set_text_Orig(self, sourceText, mtd);
+        // 数字、时间等由 GetGenericText 中的 ClassifyText 直接放行
+        const auto origText = GetStringView(sourceText);
         std::string transText;
         if (Local::GetGenericText(origText, &transText)) {
-            const auto newText = UnityResolve::UnityType::String::New(transText);
-            return Text_set_text_Orig(self, newText, mtd);
+            const auto newText = Local::GetManagedString(transText);
+            return Text_set_text_Orig(self, newText ? newText : sourceText, mtd);
         }
         if (Config::textTest) {
             Log::VerboseFmt("[TU] %s", sourceText->ToString().c_str());
@@ -175,23 +278,182 @@ namespace LinkuraLocal::HookTranslation {
         Log::DebugFmt("TextField_set_value: %s", value->ToString().c_str());
         TextField_set_value_Orig(self, value);
     }
-    // maybe we find a better way to resolve master database
-//    DEFINE_HOOK(void*, CardSkillsMaster_Fetch , (void* self, int64_t id)) {
-//        Log::DebugFmt("CardSkillsMaster_Fetch Hooked");
-//        auto result = CardSkillsMaster_Fetch_Orig(self, id);
-//        return result;
-//    }
-//
-//    DEFINE_HOOK(void, CardSkillsMaster_FetchAll, (void* self, void* mtd)) {
-//        Log::DebugFmt("CardSkillsMaster_FetchAll Hooked");
-//        CardSkillsMaster_FetchAll_Orig(self, mtd);
-//        static auto Masterbase_klass = Il2cppUtils::GetClass("Core.dll", "Silverflame.SFL", "CardSkillsMaster");
-//        static auto allValues_field = Masterbase_klass->Get<UnityResolve::Field>("allValues"); // List
-//        static auto cache_field = Masterbase_klass->Get<UnityResolve::Field>("cache"); // Dictionary
-//        auto cache = Il2cppUtils::ClassGetFieldValue<void*>(self, cache_field);
-//        Log::DebugFmt("cache is at %p", cache);
-//    }
+    // Silverflame.SFL 的 xxxMaster 在 FetchAll 时填充 allValues，此时按表整体本地化，
+    // 之后逐条 Fetch 到的对象已经是译文。表名为类名去掉末尾的 "Master"
+    using MasterFetchAll_Type = void (*)(void* self, void* mtd);
 
+    // 一个 master 类在安装钩子时解析好的信息
+    struct MasterClassInfo {
+        Il2cppUtils::Il2CppClassHead* klass = nullptr;
+        std::string tableName{};
+        Il2cppUtils::FieldInfo* allValuesField = nullptr;  // List<T>
+        // cache 字段（Dictionary<TKey, T>）中的对象可能早于 FetchAll 单独创建，不一定在 allValues 中，
+        // 通过 get_Values().CopyTo(T[], int) 取出后补充本地化
+        Il2cppUtils::FieldInfo* cacheField = nullptr;
+        Il2cppUtils::MethodInfo* cacheGetCount = nullptr;
+        Il2cppUtils::MethodInfo* cacheGetValues = nullptr;
+        Il2cppUtils::MethodInfo* valuesCopyTo = nullptr;
+        void* valuesArrayClass = nullptr;
+    };
+
+    constexpr std::string_view kMasterNamespace = "Silverflame.SFL";
+    constexpr std::string_view kMasterClassSuffix = "Master";
+    // FetchAll 钩子的槽位数，每个不同的 FetchAll 地址占一个
+    constexpr size_t kMaxMasterFetchAllHooks = 256;
+
+    // Install 中一次性填好，之后只读
+    std::vector<MasterClassInfo> masterClasses{};
+    std::array<MasterFetchAll_Type, kMaxMasterFetchAllHooks> masterFetchAllOrig{};
+
+    Il2cppUtils::Il2CppClassHead* ClassFromType(void* type) {
+        if (!type) return nullptr;
+        return UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>("il2cpp_class_from_type", type);
+    }
+
+    void ResolveMasterCache(MasterClassInfo& info) {
+        info.cacheField = UnityResolve::Invoke<Il2cppUtils::FieldInfo*>("il2cpp_class_get_field_from_name", info.klass, "cache");
+        if (!info.cacheField) return;
+        const auto dictClass = ClassFromType(UnityResolve::Invoke<void*>("il2cpp_field_get_type", info.cacheField));
+        if (!dictClass) return;
+        info.cacheGetCount = Il2cppUtils::il2cpp_class_get_method_from_name(dictClass, "get_Count", 0);
+        info.cacheGetValues = Il2cppUtils::il2cpp_class_get_method_from_name(dictClass, "get_Values", 0);
+        if (!info.cacheGetCount || !info.cacheGetValues) return;
+        const auto valuesClass = ClassFromType(UnityResolve::Invoke<void*>("il2cpp_method_get_return_type", info.cacheGetValues));
+        if (!valuesClass) return;
+        info.valuesCopyTo = Il2cppUtils::il2cpp_class_get_method_from_name(valuesClass, "CopyTo", 2);
+        if (!info.valuesCopyTo) return;
+        const auto arrayClass = ClassFromType(UnityResolve::Invoke<void*>("il2cpp_method_get_param", info.valuesCopyTo, 0));
+        if (!arrayClass) return;
+        // 值类型的元素不是对象指针，不处理
+        const auto elementClass = UnityResolve::Invoke<void*>("il2cpp_class_get_element_class", arrayClass);
+        if (!elementClass || UnityResolve::Invoke<bool>("il2cpp_class_is_valuetype", elementClass)) return;
+        info.valuesArrayClass = arrayClass;
+    }
+
+    // 不是 master 类（没有 allValues 或类名不以 Master 结尾）时返回 false
+    bool ResolveMasterClass(Il2cppUtils::Il2CppClassHead* klass, MasterClassInfo& info) {
+        const std::string_view className = UnityResolve::Invoke<const char*>("il2cpp_class_get_name", klass);
+        if (!className.ends_with(kMasterClassSuffix) || className.size() == kMasterClassSuffix.size()) return false;
+        info.allValuesField = UnityResolve::Invoke<Il2cppUtils::FieldInfo*>("il2cpp_class_get_field_from_name", klass, "allValues");
+        if (!info.allValuesField) return false;
+        info.klass = klass;
+        info.tableName = className.substr(0, className.size() - kMasterClassSuffix.size());
+        ResolveMasterCache(info);
+        return true;
+    }
+
+    // cache 中不在 allValues 里的对象
+    std::vector<void*> CollectUnlistedCacheValues(void* master, const MasterClassInfo& info, void* allValues) {
+        if (!info.valuesArrayClass) return {};
+        const auto cache = Il2cppUtils::ClassGetFieldValue<void*>(master, info.cacheField);
+        if (!cache) return {};
+        const auto count = reinterpret_cast<int (*)(void*, void*)>(info.cacheGetCount->methodPointer)(cache, info.cacheGetCount);
+        if (count <= 0) return {};
+        const auto values = reinterpret_cast<void* (*)(void*, void*)>(info.cacheGetValues->methodPointer)(cache, info.cacheGetValues);
+        if (!values) return {};
+        const auto array = UnityResolve::Invoke<UnityResolve::UnityType::Array<void*>*>("il2cpp_array_new_specific",
+                                                                                       info.valuesArrayClass, static_cast<uintptr_t>(count));
+        if (!array) return {};
+        reinterpret_cast<void (*)(void*, void*, int, void*)>(info.valuesCopyTo->methodPointer)(values, array, 0, info.valuesCopyTo);
+
+        std::unordered_set<void*> listed{};
+        if (allValues) {
+            Il2cppUtils::Tools::CSListEditor<void*> listEditor(allValues);
+            const auto listCount = listEditor.get_Count();
+            listed.reserve(listCount);
+            for (int i = 0; i < listCount; i++) {
+                listed.insert(listEditor.get_Item(i));
+            }
+        }
+        std::vector<void*> ret{};
+        for (uintptr_t i = 0; i < array->max_length; i++) {
+            const auto item = array->At(i);
+            if (item && !listed.contains(item)) ret.push_back(item);
+        }
+        return ret;
+    }
+
+    void LocalizeMasterAllValues(void* master) {
+        const auto klass = Il2cppUtils::get_class_from_instance(master);
+        const MasterClassInfo* info = nullptr;
+        for (const auto& masterClass : masterClasses) {
+            if (masterClass.klass == klass) {
+                info = &masterClass;
+                break;
+            }
+        }
+        // 派生类共用基类的 FetchAll 时按实际的类解析
+        MasterClassInfo runtimeInfo{};
+        if (!info) {
+            if (!ResolveMasterClass(klass, runtimeInfo)) return;
+            info = &runtimeInfo;
+        }
+
+        const auto allValues = Il2cppUtils::ClassGetFieldValue<void*>(master, info->allValuesField);
+        MasterLocal::LocalizeMasterList(allValues, info->tableName);
+        const auto unlisted = CollectUnlistedCacheValues(master, *info, allValues);
+        if (!unlisted.empty()) {
+            Log::DebugFmt("%s: localize %zu cached objects not in allValues", info->tableName.c_str(), unlisted.size());
+            MasterLocal::LocalizeMasterItems(unlisted, info->tableName);
+        }
+    }
+
+    template <size_t Index>
+    void MasterFetchAll_Hook(void* self, void* mtd) {
+        masterFetchAllOrig[Index](self, mtd);
+        LocalizeMasterAllValues(self);
+    }
+
+    template <size_t... Index>
+    constexpr std::array<MasterFetchAll_Type, sizeof...(Index)> MakeMasterFetchAllHooks(std::index_sequence<Index...>) {
+        return { &MasterFetchAll_Hook<Index>... };
+    }
+
+    constexpr auto masterFetchAllHooks = MakeMasterFetchAllHooks(std::make_index_sequence<kMaxMasterFetchAllHooks>{});
+
+    // 遍历 Core.dll 中 Silverflame.SFL 命名空间下的 xxxMaster 类，给各自的 FetchAll 装上钩子。
+    // 不依赖 UnityResolve 的类列表（lazyInit 时不完整），直接遍历 image
+    void InstallMasterFetchAllHooks(HookInstaller* hookInstaller) {
+        const auto assembly = UnityResolve::Get("Core.dll");
+        if (!assembly) return;
+        const auto image = UnityResolve::Invoke<void*>("il2cpp_assembly_get_image", assembly->address);
+        const auto classCount = UnityResolve::Invoke<size_t>("il2cpp_image_get_class_count", image);
+
+        std::vector<std::pair<void*, std::string>> fetchAllMethods{};
+        for (size_t i = 0; i < classCount; i++) {
+            const auto klass = UnityResolve::Invoke<Il2cppUtils::Il2CppClassHead*>("il2cpp_image_get_class", image, i);
+            if (!klass || UnityResolve::Invoke<const char*>("il2cpp_class_get_namespace", klass) != kMasterNamespace) continue;
+            MasterClassInfo info{};
+            if (!ResolveMasterClass(klass, info)) continue;
+            const auto fetchAll = Il2cppUtils::il2cpp_class_get_method_from_name(klass, "FetchAll", 0);
+            if (!fetchAll || !fetchAll->methodPointer) continue;
+            fetchAllMethods.emplace_back(reinterpret_cast<void*>(fetchAll->methodPointer), info.tableName);
+            masterClasses.push_back(std::move(info));
+        }
+
+        // 先填好 masterClasses 再安装，钩子生效后只读取
+        std::unordered_set<void*> hookedAddresses{};
+        size_t slot = 0;
+        for (const auto& [addr, tableName] : fetchAllMethods) {
+            // 共用同一份代码的 FetchAll 只装一次，钩子里按实际的类区分
+            if (!hookedAddresses.insert(addr).second) continue;
+            if (slot == kMaxMasterFetchAllHooks) {
+                Log::ErrorFmt("ADD_HOOK: too many master FetchAll methods, %s and later are not hooked", tableName.c_str());
+                break;
+            }
+            const auto stub = hookInstaller->InstallHook(addr, reinterpret_cast<void*>(masterFetchAllHooks[slot]),
+                                                         reinterpret_cast<void**>(&masterFetchAllOrig[slot]));
+            if (stub == NULL) {
+                int error_num = shadowhook_get_errno();
+                const char *error_msg = shadowhook_to_errmsg(error_num);
+                Log::ErrorFmt("ADD_HOOK: %sMaster_FetchAll at %p failed: %s", tableName.c_str(), addr, error_msg);
+                continue;
+            }
+            hookedStubs.emplace(stub);
+            slot++;
+        }
+        Log::InfoFmt("ADD_HOOK: %zu master FetchAll methods for %zu tables", slot, masterClasses.size());
+    }
 
     void Install(HookInstaller* hookInstaller) {
         ADD_HOOK(TextMeshProUGUI_Awake, Il2cppUtils::GetMethodPointer("Unity.TextMeshPro.dll", "TMPro",
@@ -200,6 +462,10 @@ namespace LinkuraLocal::HookTranslation {
         ADD_HOOK(TMP_Text_PopulateTextBackingArray, Il2cppUtils::GetMethodPointer("Unity.TextMeshPro.dll", "TMPro",
                                                                                   "TMP_Text", "PopulateTextBackingArray",
                                                                                   {"System.String", "System.Int32", "System.Int32"}));
+        ADD_HOOK(TextMeshProUGUI_OnDestroy, Il2cppUtils::GetMethodPointer("Unity.TextMeshPro.dll", "TMPro",
+                                                                          "TextMeshProUGUI", "OnDestroy"));
+        ADD_HOOK(TextMeshPro_OnDestroy, Il2cppUtils::GetMethodPointer("Unity.TextMeshPro.dll", "TMPro",
+                                                                      "TextMeshPro", "OnDestroy"));
         ADD_HOOK(TMP_Text_SetText_2, Il2cppUtils::GetMethodPointer("Unity.TextMeshPro.dll", "TMPro",
                                                                    "TMP_Text", "SetText",
                                                                    { "System.String", "System.Boolean" }));
@@ -207,9 +473,6 @@ namespace LinkuraLocal::HookTranslation {
         ADD_HOOK(TextField_set_value, Il2cppUtils::GetMethodPointer("UnityEngine.UIElementsModule.dll", "UnityEngine.UIElements",
                                                                     "TextField", "set_value"));
         ADD_HOOK(Text_set_text, Il2cppUtils::GetMethodPointer("UnityEngine.UI.dll", "UnityEngine.UI", "Text", "set_text"));
-//        ADD_HOOK(CardSkillsMaster_Fetch, Il2cppUtils::GetMethodPointer("Core.dll", "Silverflame.SFL",
-//                                                                            "CardSkillsMaster", "Fetch"));
-//        ADD_HOOK(CardSkillsMaster_FetchAll, Il2cppUtils::GetMethodPointer("Core.dll", "Silverflame.SFL",
-//                                                                          "CardSkillsMaster", "FetchAll"));
+        InstallMasterFetchAllHooks(hookInstaller);
     }
 } // LinkuraLocal
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "CompiledDict.hpp"
+#include "StringHash.hpp"
+#include "../Log.h"
+#include "../utf/Utf.hpp"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef GKMS_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace LinkuraLocal::Local {
+    namespace {
+        constexpr char kMagic[8] = {'L', 'K', 'D', 'I', 'C', 'T', '\0', '\0'};
+        constexpr size_t kTableCount = static_cast<size_t>(DictTable::Count);
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t tableCount;
+            uint64_t sourceHash;
+            uint64_t fileSize;
+            uint64_t blobOffset;
+            uint64_t blobSize;
+        };
+
+        struct TableHeader {
+            uint64_t entriesOffset;
+            uint64_t slotsOffset;
+            uint32_t entryCount;
+            uint32_t slotCount;  // 2 的幂，0 表示空表
+        };
+
+        struct Entry {
+            uint64_t hash;
+            uint32_t keyOffset;
+            uint32_t keyLength;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0);
+        static_assert(sizeof(TableHeader) % 8 == 0);
+        static_assert(sizeof(Entry) % 8 == 0);
+
+        size_t AlignUp(size_t value) {
+            return (value + 7) & ~static_cast<size_t>(7);
+        }
+
+        const FileHeader* GetHeader(const char* base) {
+            return reinterpret_cast<const FileHeader*>(base);
+        }
+
+        const TableHeader* GetTable(const char* base, DictTable table) {
+            return reinterpret_cast<const TableHeader*>(base + sizeof(FileHeader)) + static_cast<size_t>(table);
+        }
+
+        const Entry* GetEntries(const char* base, const TableHeader* table) {
+            return reinterpret_cast<const Entry*>(base + table->entriesOffset);
+        }
+
+        const uint32_t* GetSlots(const char* base, const TableHeader* table) {
+            return reinterpret_cast<const uint32_t*>(base + table->slotsOffset);
+        }
+
+        std::string_view GetBlobString(const char* base, uint32_t offset, uint32_t length) {
+            return {base + GetHeader(base)->blobOffset + offset, length};
+        }
+
+        // 缓存文件可能写了一半或被改动过，头部一致也不能直接信任：
+        // 检查每个槽位都指向有效的条目、每个条目的 key/value 都在 blob 内，并且至少留有一个空槽位
+        bool ValidateTable(const char* base, size_t dataSize, const TableHeader* table) {
+            if (table->slotCount != 0 && !std::has_single_bit(table->slotCount)) return false;
+            if (table->slotCount == 0 ? table->entryCount != 0 : table->entryCount >= table->slotCount) return false;
+            if (table->entriesOffset % alignof(Entry) != 0 || table->slotsOffset % alignof(uint32_t) != 0) return false;
+            if (table->entriesOffset > dataSize || table->slotsOffset > dataSize) return false;
+            if (static_cast<uint64_t>(table->entryCount) * sizeof(Entry) > dataSize - table->entriesOffset) return false;
+            if (static_cast<uint64_t>(table->slotCount) * sizeof(uint32_t) > dataSize - table->slotsOffset) return false;
+
+            const auto blobSize = GetHeader(base)->blobSize;
+            const auto entries = GetEntries(base, table);
+            for (uint32_t i = 0; i < table->entryCount; i++) {
+                const auto& entry = entries[i];
+                if (static_cast<uint64_t>(entry.keyOffset) + entry.keyLength > blobSize) return false;
+                if (static_cast<uint64_t>(entry.valueOffset) + entry.valueLength > blobSize) return false;
+            }
+            const auto slots = GetSlots(base, table);
+            for (uint32_t i = 0; i < table->slotCount; i++) {
+                if (slots[i] > table->entryCount) return false;
+            }
+            return true;
+        }
+
+        // UTF-16 索引表 -> 源表
+        constexpr std::pair<DictTable, DictTable> kUtf16Indexes[] = {
+                {DictTable::Utf16Generic, DictTable::Generic},
+                {DictTable::Utf16Master, DictTable::Master},
+        };
+    }
+
+    uint64_t HashUtf16Text(std::u16string_view text) {
+        return HashBytes(text.data(), text.size() * sizeof(char16_t));
+    }
+
+    CompiledDict::~CompiledDict() {
+#ifndef GKMS_WINDOWS
+        if (mapped && base) {
+            munmap(const_cast<char*>(base), size);
+        }
+#endif
+    }
+
+    bool CompiledDict::Attach(const char* data, size_t dataSize, uint64_t sourceHash, bool checkSourceHash) {
+        if (dataSize < sizeof(FileHeader) + sizeof(TableHeader) * kTableCount) return false;
+        const auto header = GetHeader(data);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) return false;
+        if (header->version != kCompiledDictVersion) return false;
+        if (header->tableCount != kTableCount) return false;
+        if (header->fileSize != dataSize) return false;
+        if (checkSourceHash && header->sourceHash != sourceHash) return false;
+        if (header->blobOffset > dataSize || header->blobSize > dataSize - header->blobOffset) return false;
+
+        for (size_t i = 0; i < kTableCount; i++) {
+            if (!ValidateTable(data, dataSize, GetTable(data, static_cast<DictTable>(i)))) {
+                Log::ErrorFmt("CompiledDict: table %zu is corrupted, rebuilding.", i);
+                return false;
+            }
+        }
+
+        base = data;
+        size = dataSize;
+        return true;
+    }
+
+    std::unique_ptr<CompiledDict> CompiledDict::Open(const std::filesystem::path& path, uint64_t sourceHash) {
+        std::unique_ptr<CompiledDict> dict(new CompiledDict());
+#ifndef GKMS_WINDOWS
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return nullptr;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return nullptr;
+        }
+        const auto fileSize = static_cast<size_t>(st.st_size);
+        void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            Log::ErrorFmt("CompiledDict: mmap %s failed.", path.string().c_str());
+            return nullptr;
+        }
+        dict->mapped = true;
+        if (!dict->Attach(static_cast<const char*>(addr), fileSize, sourceHash, true)) {
+            munmap(addr, fileSize);
+            dict->mapped = false;
+            return nullptr;
+        }
+        return dict;
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return nullptr;
+        std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        dict->ownedImage = std::move(image);
+        if (!dict->Attach(dict->ownedImage.data(), dict->ownedImage.size(), sourceHash, true)) {
+            return nullptr;
+        }
+        return dict;
+#endif
+    }
+
+    std::unique_ptr<CompiledDict> CompiledDict::FromImage(std::vector<char>&& image) {
+        std::unique_ptr<CompiledDict> dict(new CompiledDict());
+        dict->ownedImage = std::move(image);
+        if (!dict->Attach(dict->ownedImage.data(), dict->ownedImage.size(), 0, false)) {
+            return nullptr;
+        }
+        return dict;
+    }
+
+    template <typename KeyEquals>
+    bool CompiledDict::FindEntry(DictTable table, uint64_t hash, KeyEquals&& keyEquals, std::string_view* value) const {
+        if (!base) return false;
+        const auto tableHeader = GetTable(base, table);
+        if (tableHeader->slotCount == 0) return false;
+
+        const auto entries = GetEntries(base, tableHeader);
+        const auto slots = GetSlots(base, tableHeader);
+        const uint32_t mask = tableHeader->slotCount - 1;
+
+        for (uint32_t i = static_cast<uint32_t>(hash) & mask; ; i = (i + 1) & mask) {
+            const uint32_t slot = slots[i];
+            if (slot == 0) return false;
+            const auto& entry = entries[slot - 1];
+            if (entry.hash == hash && keyEquals(GetBlobString(base, entry.keyOffset, entry.keyLength))) {
+                if (value) {
+                    *value = GetBlobString(base, entry.valueOffset, entry.valueLength);
+                }
+                return true;
+            }
+        }
+    }
+
+    bool CompiledDict::Find(DictTable table, std::string_view key, std::string_view* value) const {
+        return FindEntry(table, HashText(key), [key](std::string_view entryKey) {
+            return entryKey == key;
+        }, value);
+    }
+
+    bool CompiledDict::FindUtf16(DictTable table, std::u16string_view key, std::string_view* value) const {
+        return FindEntry(table, HashUtf16Text(key), [key](std::string_view entryKey) {
+            return Utf::Utf8EqualsUtf16(entryKey, key);
+        }, value);
+    }
+
+    bool CompiledDict::FindHashedImpl(DictTable table, uint64_t hash, KeyEqualsFn keyEquals, const void* context, std::string_view* value) const {
+        return FindEntry(table, hash, [keyEquals, context](std::string_view entryKey) {
+            return keyEquals(context, entryKey);
+        }, value);
+    }
+
+    bool CompiledDict::Contains(DictTable table, std::string_view key) const {
+        return Find(table, key, nullptr);
+    }
+
+    size_t CompiledDict::Size(DictTable table) const {
+        if (!base) return 0;
+        return GetTable(base, table)->entryCount;
+    }
+
+    std::string_view CompiledDict::KeyAt(DictTable table, size_t index) const {
+        const auto tableHeader = GetTable(base, table);
+        const auto& entry = GetEntries(base, tableHeader)[index];
+        return GetBlobString(base, entry.keyOffset, entry.keyLength);
+    }
+
+    std::string_view CompiledDict::ValueAt(DictTable table, size_t index) const {
+        const auto tableHeader = GetTable(base, table);
+        const auto& entry = GetEntries(base, tableHeader)[index];
+        return GetBlobString(base, entry.valueOffset, entry.valueLength);
+    }
+
+    uint32_t CompiledDictBuilder::AppendBlob(std::string_view str) {
+        // 译文会同时出现在多张表里（例如 Translated），相同字符串只存一份
+        if (auto it = blobIndex.find(std::string(str)); it != blobIndex.end()) {
+            return it->second;
+        }
+        const auto offset = static_cast<uint32_t>(blob.size());
+        blob.append(str);
+        blobIndex.emplace(str, offset);
+        return offset;
+    }
+
+    void CompiledDictBuilder::Add(DictTable table, std::string_view key, std::string_view value) {
+        auto& target = entries[static_cast<size_t>(table)];
+        target.push_back(PendingEntry{
+            .hash = HashText(key),
+            .keyOffset = AppendBlob(key),
+            .keyLength = static_cast<uint32_t>(key.size()),
+            // 空 value 不占用 blob 空间
+            .valueOffset = value.empty() ? 0 : AppendBlob(value),
+            .valueLength = static_cast<uint32_t>(value.size()),
+        });
+    }
+
+    std::vector<char> CompiledDictBuilder::Build(uint64_t sourceHash) const {
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kCompiledDictVersion;
+        header.tableCount = kTableCount;
+        header.sourceHash = sourceHash;
+
+        // 生成 UTF-16 索引：与源表共用 key/value，只替换哈希
+        std::vector<PendingEntry> utf16Entries[std::size(kUtf16Indexes)];
+        const std::vector<PendingEntry>* tableEntries[kTableCount];
+        for (size_t i = 0; i < kTableCount; i++) {
+            tableEntries[i] = &entries[i];
+        }
+        std::u16string utf16Key;
+        for (size_t n = 0; n < std::size(kUtf16Indexes); n++) {
+            const auto [indexTable, sourceTable] = kUtf16Indexes[n];
+            for (const auto& entry : entries[static_cast<size_t>(sourceTable)]) {
+                if (!Utf::Utf8ToUtf16(std::string_view(blob).substr(entry.keyOffset, entry.keyLength), &utf16Key)) continue;
+                auto& indexEntry = utf16Entries[n].emplace_back(entry);
+                indexEntry.hash = HashUtf16Text(utf16Key);
+            }
+            tableEntries[static_cast<size_t>(indexTable)] = &utf16Entries[n];
+        }
+
+        TableHeader tables[kTableCount]{};
+        size_t offset = sizeof(FileHeader) + sizeof(TableHeader) * kTableCount;
+        for (size_t i = 0; i < kTableCount; i++) {
+            const auto entryCount = tableEntries[i]->size();
+            tables[i].entryCount = static_cast<uint32_t>(entryCount);
+            // 负载因子不超过 0.5
+            tables[i].slotCount = entryCount == 0 ? 0 : std::bit_ceil(static_cast<uint32_t>(entryCount * 2));
+            tables[i].entriesOffset = offset;
+            offset = AlignUp(offset + sizeof(Entry) * entryCount);
+            tables[i].slotsOffset = offset;
+            offset = AlignUp(offset + sizeof(uint32_t) * tables[i].slotCount);
+        }
+        header.blobOffset = offset;
+        header.blobSize = blob.size();
+        header.fileSize = offset + blob.size();
+
+        std::vector<char> image(header.fileSize, 0);
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::memcpy(image.data() + sizeof(header), tables, sizeof(tables));
+
+        for (size_t i = 0; i < kTableCount; i++) {
+            const auto& table = tables[i];
+            auto outEntries = reinterpret_cast<Entry*>(image.data() + table.entriesOffset);
+            auto outSlots = reinterpret_cast<uint32_t*>(image.data() + table.slotsOffset);
+            const uint32_t mask = table.slotCount - 1;
+
+            for (size_t idx = 0; idx < tableEntries[i]->size(); idx++) {
+                const auto& pending = (*tableEntries[i])[idx];
+                outEntries[idx] = Entry{
+                    .hash = pending.hash,
+                    .keyOffset = pending.keyOffset,
+                    .keyLength = pending.keyLength,
+                    .valueOffset = pending.valueOffset,
+                    .valueLength = pending.valueLength,
+                };
+                for (uint32_t slot = static_cast<uint32_t>(pending.hash) & mask; ; slot = (slot + 1) & mask) {
+                    if (outSlots[slot] == 0) {
+                        outSlots[slot] = static_cast<uint32_t>(idx + 1);
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::memcpy(image.data() + header.blobOffset, blob.data(), blob.size());
+        return image;
+    }
+
+    bool WriteCompiledDict(const std::filesystem::path& path, const std::vector<char>& image) {
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        try {
+            {
+                std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    Log::ErrorFmt("WriteCompiledDict: open %s failed.", tmpPath.string().c_str());
+                    return false;
+                }
+                file.write(image.data(), static_cast<std::streamsize>(image.size()));
+                if (!file.good()) {
+                    Log::ErrorFmt("WriteCompiledDict: write %s failed.", tmpPath.string().c_str());
+                    return false;
+                }
+            }
+            std::filesystem::rename(tmpPath, path);
+            return true;
+        }
+        catch (std::exception& e) {
+            Log::ErrorFmt("WriteCompiledDict %s failed: %s", path.string().c_str(), e.what());
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+}
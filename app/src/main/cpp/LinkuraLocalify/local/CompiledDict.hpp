@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 编译后的翻译词典：一个文件内包含若干张开放寻址哈希表和一整块字符串数据，
+    // 启动时直接 mmap，查询结果是指向映射区域的 string_view，不产生任何堆分配。
+    //
+    // 文件布局:
+    //   FileHeader | TableHeader[DictTable::Count] | (Entry[] | uint32 slot[]) * Count | string blob
+    //
+    // 修改文件布局、哈希算法或 Local::LoadData 的加载逻辑后需要提升此版本号，旧缓存会自动失效
+    constexpr uint32_t kCompiledDictVersion = 3;
+
+    enum class DictTable : uint32_t {
+        Generic,
+        Master,
+        Split,
+        Fmt,
+        Translated,   // 仅 key，用于判断文本是否已是译文
+        Regex,        // 有序：key 为原始模板，value 为译文
+        RegexPattern, // 有序：与 Regex 一一对应，key 为转换后的正则表达式
+        MasterTableFiles, // 有序：rules/data 格式的 masterTrans 文件路径，由 MasterLocal 加载
+        Utf16Generic, // Generic 的 UTF-16 索引：哈希按 key 的 UTF-16 编码计算，key/value 与 Generic 共用，构建时自动生成
+        Utf16Master,  // Master 的 UTF-16 索引
+        Count
+    };
+
+    class CompiledDict {
+    public:
+        CompiledDict(const CompiledDict&) = delete;
+        CompiledDict& operator=(const CompiledDict&) = delete;
+        ~CompiledDict();
+
+        // 打开缓存文件，文件不存在、版本或 sourceHash 不一致时返回 nullptr
+        static std::unique_ptr<CompiledDict> Open(const std::filesystem::path& path, uint64_t sourceHash);
+        // 直接使用内存中的镜像（缓存文件无法写入时的回退方案）
+        static std::unique_ptr<CompiledDict> FromImage(std::vector<char>&& image);
+
+        bool Find(DictTable table, std::string_view key, std::string_view* value) const;
+        bool Contains(DictTable table, std::string_view key) const;
+        // 直接用托管字符串的 UTF-16 内容查询 Utf16* 索引，不做转码也不分配内存
+        bool FindUtf16(DictTable table, std::u16string_view key, std::string_view* value) const;
+        // 用调用方算好的 HashText(key) 查询，key 由 keyEquals(entryKey) 判断是否相等，
+        // 用于 key 可以分段比较、不必拼出完整字符串的场景
+        template <typename KeyEquals>
+        bool FindHashed(DictTable table, uint64_t hash, const KeyEquals& keyEquals, std::string_view* value) const {
+            return FindHashedImpl(table, hash, [](const void* context, std::string_view entryKey) {
+                return (*static_cast<const KeyEquals*>(context))(entryKey);
+            }, &keyEquals, value);
+        }
+
+        [[nodiscard]] size_t Size(DictTable table) const;
+        // 按写入顺序读取第 index 项
+        [[nodiscard]] std::string_view KeyAt(DictTable table, size_t index) const;
+        [[nodiscard]] std::string_view ValueAt(DictTable table, size_t index) const;
+
+        [[nodiscard]] size_t ByteSize() const { return size; }
+        [[nodiscard]] bool IsMapped() const { return mapped; }
+
+    private:
+        CompiledDict() = default;
+        bool Attach(const char* data, size_t size, uint64_t sourceHash, bool checkSourceHash);
+        using KeyEqualsFn = bool (*)(const void* context, std::string_view entryKey);
+        bool FindHashedImpl(DictTable table, uint64_t hash, KeyEqualsFn keyEquals, const void* context, std::string_view* value) const;
+        template <typename KeyEquals>
+        bool FindEntry(DictTable table, uint64_t hash, KeyEquals&& keyEquals, std::string_view* value) const;
+
+        const char* base = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+        std::vector<char> ownedImage{};
+    };
+
+    // UTF-16 索引使用的哈希
+    uint64_t HashUtf16Text(std::u16string_view text);
+
+    class CompiledDictBuilder {
+    public:
+        void Add(DictTable table, std::string_view key, std::string_view value = {});
+        [[nodiscard]] std::vector<char> Build(uint64_t sourceHash) const;
+
+    private:
+        struct PendingEntry {
+            uint64_t hash;
+            uint32_t keyOffset;
+            uint32_t keyLength;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+        };
+
+        uint32_t AppendBlob(std::string_view str);
+
+        std::vector<PendingEntry> entries[static_cast<size_t>(DictTable::Count)]{};
+        std::string blob{};
+        std::unordered_map<std::string, uint32_t> blobIndex{};
+    };
+
+    // 先写入临时文件再 rename，避免其它进程读到写了一半的缓存
+    bool WriteCompiledDict(const std::filesystem::path& path, const std::vector<char>& image);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "FlatStringMap.hpp"
+#include "StringHash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 只判断“文本是否在集合中”的紧凑集合，不保存字符串本身。
+    // 每个元素只存两个独立的 64 位哈希，查询时两者都相同才算命中，误判概率约为 元素数 / 2^128。
+    // 插入时若主哈希相同而校验哈希不同，说明两个不同的字符串发生了碰撞，
+    // 碰撞的字符串原样存入 collisions，查询时精确比较，保证集合内的文本不会漏判。
+    class FingerprintSet {
+    public:
+        FingerprintSet() = default;
+        FingerprintSet(FingerprintSet&&) noexcept = default;
+        FingerprintSet& operator=(FingerprintSet&&) noexcept = default;
+        FingerprintSet(const FingerprintSet&) = delete;
+        FingerprintSet& operator=(const FingerprintSet&) = delete;
+
+        bool Insert(std::string_view text) {
+            const auto fingerprint = MakeFingerprint(text);
+            if ((count + 1) * 4 > slots.size() * 3) {
+                Rehash(std::max<size_t>(16, slots.size() * 2));
+            }
+            const size_t mask = slots.size() - 1;
+            for (size_t i = fingerprint.hash & mask; ; i = (i + 1) & mask) {
+                auto& slot = slots[i];
+                if (slot.IsEmpty()) {
+                    slot = fingerprint;
+                    count++;
+                    return true;
+                }
+                if (slot.hash != fingerprint.hash) continue;
+                if (slot.check == fingerprint.check) return false;
+                // 主哈希碰撞，后来的字符串改为精确保存
+                return collisions.Insert(text);
+            }
+        }
+
+        [[nodiscard]] bool Contains(std::string_view text) const {
+            if (slots.empty()) return false;
+            const auto fingerprint = MakeFingerprint(text);
+            const size_t mask = slots.size() - 1;
+            for (size_t i = fingerprint.hash & mask; ; i = (i + 1) & mask) {
+                const auto& slot = slots[i];
+                if (slot.IsEmpty()) return false;
+                if (slot.hash != fingerprint.hash) continue;
+                if (slot.check == fingerprint.check) return true;
+                return !collisions.empty() && collisions.Contains(text);
+            }
+        }
+
+        // 复制一份。已发布给读者的集合不能修改，追加元素时在副本上进行
+        [[nodiscard]] FingerprintSet Clone() const {
+            FingerprintSet ret;
+            ret.slots = slots;
+            ret.count = count;
+            collisions.ForEach([&ret](std::string_view text) { ret.collisions.Insert(text); });
+            return ret;
+        }
+
+        // 加载完成后调用，按实际元素数收缩表，释放扩容时多出来的空间
+        void ShrinkToFit() {
+            const auto slotCount = count == 0 ? 0 : std::max<size_t>(16, std::bit_ceil(count * 4 / 3 + 1));
+            if (slotCount < slots.size()) Rehash(slotCount);
+        }
+
+        void Clear() {
+            std::vector<Fingerprint>().swap(slots);
+            collisions.Clear();
+            count = 0;
+        }
+
+        [[nodiscard]] size_t size() const { return count + collisions.size(); }
+        [[nodiscard]] bool empty() const { return size() == 0; }
+        [[nodiscard]] size_t CollisionCount() const { return collisions.size(); }
+
+        [[nodiscard]] size_t MemoryBytes() const {
+            return slots.capacity() * sizeof(Fingerprint) + collisions.MemoryBytes();
+        }
+
+    private:
+        // 校验哈希使用不同的种子，与主哈希相互独立
+        static constexpr uint64_t kCheckSeed = 0x9e3779b97f4a7c15ULL;
+
+        struct Fingerprint {
+            uint64_t hash = 0;
+            uint64_t check = 0;
+
+            [[nodiscard]] bool IsEmpty() const { return hash == 0 && check == 0; }
+        };
+
+        static Fingerprint MakeFingerprint(std::string_view text) {
+            Fingerprint fingerprint{HashText(text), HashBytes(text.data(), text.size(), kCheckSeed)};
+            if (fingerprint.IsEmpty()) fingerprint.check = 1;  // 全 0 表示空槽
+            return fingerprint;
+        }
+
+        void Rehash(size_t slotCount) {
+            std::vector<Fingerprint> old(slotCount);
+            old.swap(slots);
+            const size_t mask = slots.size() - 1;
+            for (const auto& fingerprint : old) {
+                if (fingerprint.IsEmpty()) continue;
+                size_t i = fingerprint.hash & mask;
+                while (!slots[i].IsEmpty()) i = (i + 1) & mask;
+                slots[i] = fingerprint;
+            }
+        }
+
+        std::vector<Fingerprint> slots{};
+        size_t count = 0;
+        FlatStringSet collisions{};
+    };
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "StringHash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 只追加的字符串存储：按块分配，存入的字符串在 arena 清空或销毁前地址不变
+    class StringArena {
+    public:
+        static constexpr size_t kBlockSize = 64 * 1024;
+
+        StringArena() = default;
+        // 被移动后的 arena 不能再指向已转交的块，否则之后的 Store 会写入对方的内存
+        StringArena(StringArena&& other) noexcept
+                : blocks(std::move(other.blocks)),
+                  cursor(std::exchange(other.cursor, nullptr)),
+                  remaining(std::exchange(other.remaining, 0)),
+                  allocatedBytes(std::exchange(other.allocatedBytes, 0)) {
+            other.blocks.clear();
+        }
+
+        StringArena& operator=(StringArena&& other) noexcept {
+            if (this == &other) return *this;
+            blocks = std::move(other.blocks);
+            other.blocks.clear();
+            cursor = std::exchange(other.cursor, nullptr);
+            remaining = std::exchange(other.remaining, 0);
+            allocatedBytes = std::exchange(other.allocatedBytes, 0);
+            return *this;
+        }
+
+        StringArena(const StringArena&) = delete;
+        StringArena& operator=(const StringArena&) = delete;
+
+        std::string_view Store(std::string_view text) {
+            if (text.empty()) return {};
+            // 大字符串单独占一块，不打断当前块
+            if (text.size() > kBlockSize / 4) {
+                auto& block = blocks.emplace_back(std::make_unique_for_overwrite<char[]>(text.size()));
+                allocatedBytes += text.size();
+                std::memcpy(block.get(), text.data(), text.size());
+                return {block.get(), text.size()};
+            }
+            if (text.size() > remaining) {
+                cursor = blocks.emplace_back(std::make_unique_for_overwrite<char[]>(kBlockSize)).get();
+                remaining = kBlockSize;
+                allocatedBytes += kBlockSize;
+            }
+            std::memcpy(cursor, text.data(), text.size());
+            const std::string_view stored(cursor, text.size());
+            cursor += text.size();
+            remaining -= text.size();
+            return stored;
+        }
+
+        void Clear() {
+            std::vector<std::unique_ptr<char[]>>().swap(blocks);
+            cursor = nullptr;
+            remaining = 0;
+            allocatedBytes = 0;
+        }
+
+        [[nodiscard]] size_t ByteSize() const { return allocatedBytes; }
+
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks{};
+        char* cursor = nullptr;
+        size_t remaining = 0;
+        size_t allocatedBytes = 0;
+    };
+
+    // 以 string_view 为键的开放寻址哈希表，键存放在内部的 StringArena 中，查询不需要构造 std::string。
+    // 条目按插入顺序连续存放，不支持删除。V 为 std::string_view 时可用 EmplaceText / AssignText 把值也存入 arena
+    template <typename V>
+    class FlatStringMap {
+    public:
+        struct Entry {
+            std::string_view key;
+            V value;
+        };
+
+        FlatStringMap() = default;
+        FlatStringMap(FlatStringMap&&) noexcept = default;
+        FlatStringMap& operator=(FlatStringMap&&) noexcept = default;
+        FlatStringMap(const FlatStringMap&) = delete;
+        FlatStringMap& operator=(const FlatStringMap&) = delete;
+
+        [[nodiscard]] const V* Find(std::string_view key) const {
+            const auto index = FindIndex(key, HashText(key));
+            return index ? &entries[index - 1].value : nullptr;
+        }
+
+        [[nodiscard]] bool Contains(std::string_view key) const {
+            return FindIndex(key, HashText(key)) != 0;
+        }
+
+        // 键已存在时保留原值，返回 false
+        bool Emplace(std::string_view key, V value) {
+            const auto [entry, inserted] = FindOrInsert(key);
+            if (inserted) entry->value = std::move(value);
+            return inserted;
+        }
+
+        void InsertOrAssign(std::string_view key, V value) {
+            FindOrInsert(key).first->value = std::move(value);
+        }
+
+        bool EmplaceText(std::string_view key, std::string_view value) requires std::is_same_v<V, std::string_view> {
+            const auto [entry, inserted] = FindOrInsert(key);
+            if (inserted) entry->value = arena.Store(value);
+            return inserted;
+        }
+
+        // 覆盖时旧值仍占用 arena，直到 Clear
+        void AssignText(std::string_view key, std::string_view value) requires std::is_same_v<V, std::string_view> {
+            auto& current = FindOrInsert(key).first->value;
+            if (current != value) current = arena.Store(value);
+        }
+
+        // 把值中引用的字符串存入同一个 arena，与表同生命周期
+        std::string_view Store(std::string_view text) {
+            return arena.Store(text);
+        }
+
+        void Reserve(size_t count) {
+            entries.reserve(count);
+            hashes.reserve(count);
+            if (count * 2 > slots.size()) Rehash(std::bit_ceil(count * 2));
+        }
+
+        void Clear() {
+            std::vector<Entry>().swap(entries);
+            std::vector<uint64_t>().swap(hashes);
+            std::vector<uint32_t>().swap(slots);
+            arena.Clear();
+        }
+
+        [[nodiscard]] size_t size() const { return entries.size(); }
+        [[nodiscard]] bool empty() const { return entries.empty(); }
+        [[nodiscard]] auto begin() const { return entries.cbegin(); }
+        [[nodiscard]] auto end() const { return entries.cend(); }
+
+        // 表结构和 arena 占用的字节数，不含值内部的堆内存
+        [[nodiscard]] size_t MemoryBytes() const {
+            return entries.capacity() * sizeof(Entry) + hashes.capacity() * sizeof(uint64_t) +
+                   slots.capacity() * sizeof(uint32_t) + arena.ByteSize();
+        }
+
+    private:
+        // 返回 entries 下标 + 1，不存在时返回 0
+        [[nodiscard]] uint32_t FindIndex(std::string_view key, uint64_t hash) const {
+            if (slots.empty()) return 0;
+            const size_t mask = slots.size() - 1;
+            for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+                const auto slot = slots[i];
+                if (slot == 0) return 0;
+                if (hashes[slot - 1] == hash && entries[slot - 1].key == key) return slot;
+            }
+        }
+
+        std::pair<Entry*, bool> FindOrInsert(std::string_view key) {
+            const auto hash = HashText(key);
+            if (const auto index = FindIndex(key, hash)) {
+                return {&entries[index - 1], false};
+            }
+            // 负载不超过 1/2
+            if ((entries.size() + 1) * 2 > slots.size()) {
+                Rehash(std::max<size_t>(16, slots.size() * 2));
+            }
+            entries.push_back({arena.Store(key), V{}});
+            hashes.push_back(hash);
+            PlaceSlot(hash, static_cast<uint32_t>(entries.size()));
+            return {&entries.back(), true};
+        }
+
+        void PlaceSlot(uint64_t hash, uint32_t slot) {
+            const size_t mask = slots.size() - 1;
+            size_t i = hash & mask;
+            while (slots[i] != 0) i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+
+        void Rehash(size_t slotCount) {
+            slots.assign(slotCount, 0);
+            for (size_t i = 0; i < hashes.size(); i++) {
+                PlaceSlot(hashes[i], static_cast<uint32_t>(i + 1));
+            }
+        }
+
+        StringArena arena{};
+        std::vector<Entry> entries{};
+        std::vector<uint64_t> hashes{};
+        std::vector<uint32_t> slots{};
+    };
+
+    using TextMap = FlatStringMap<std::string_view>;
+
+    // 只判断是否存在的字符串集合
+    class FlatStringSet {
+    public:
+        bool Insert(std::string_view text) {
+            return map.Emplace(text, {});
+        }
+
+        [[nodiscard]] bool Contains(std::string_view text) const {
+            return map.Contains(text);
+        }
+
+        template <typename Fn>
+        void ForEach(Fn&& fn) const {
+            for (const auto& entry : map) fn(entry.key);
+        }
+
+        void Clear() { map.Clear(); }
+        [[nodiscard]] size_t size() const { return map.size(); }
+        [[nodiscard]] bool empty() const { return map.empty(); }
+        [[nodiscard]] size_t MemoryBytes() const { return map.MemoryBytes(); }
+
+    private:
+        struct Empty {};
+        FlatStringMap<Empty> map{};
+    };
+}
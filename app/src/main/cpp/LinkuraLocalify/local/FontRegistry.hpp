@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 已经替换过 sourceFontFile 的 TMP_FontAsset。
+    // 替换用的字体重新创建时提升 generation，旧记录在下次遇到时各自重新处理，不会整体清空；
+    // 已销毁的字体资源由 Sweep 每次检查少量记录逐步移除。仅在主线程访问
+    class FontAssetRegistry {
+    public:
+        [[nodiscard]] bool IsPatched(void* asset) const {
+            const auto it = index.find(asset);
+            return it != index.end() && entries[it->second].generation == generation;
+        }
+
+        void MarkPatched(void* asset) {
+            if (const auto [it, inserted] = index.try_emplace(asset, entries.size()); !inserted) {
+                entries[it->second].generation = generation;
+                return;
+            }
+            entries.push_back({asset, generation});
+        }
+
+        void NewGeneration() {
+            generation++;
+        }
+
+        // 从上次的位置继续检查最多 budget 条记录，isAlive 返回 false 的记录被移除
+        template <typename IsAlive>
+        void Sweep(size_t budget, IsAlive&& isAlive) {
+            for (size_t n = 0; n < budget && !entries.empty(); n++) {
+                if (cursor >= entries.size()) cursor = 0;
+                if (isAlive(entries[cursor].asset)) {
+                    cursor++;
+                    continue;
+                }
+                // 末尾记录移到当前位置，下一轮检查它
+                index.erase(entries[cursor].asset);
+                if (cursor + 1 != entries.size()) {
+                    entries[cursor] = entries.back();
+                    index[entries[cursor].asset] = cursor;
+                }
+                entries.pop_back();
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return entries.size(); }
+        [[nodiscard]] uint32_t Generation() const { return generation; }
+
+    private:
+        struct Entry {
+            void* asset;
+            uint32_t generation;
+        };
+
+        std::vector<Entry> entries{};
+        std::unordered_map<void*, size_t> index{};
+        size_t cursor = 0;
+        uint32_t generation = 0;
+    };
+}
@@ -0,0 +1,95 @@
+#include "ManagedStringCache.hpp"
+#include "StringHash.hpp"
+#include "../Local.h"
+#include "../Log.h"
+#include "../utf/Utf.hpp"
+
+#include <bit>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    uint32_t PinManagedObject(void* obj) {
+        return UnityResolve::Invoke<uint32_t>("il2cpp_gchandle_new", obj, true);
+    }
+
+    void ReleaseManagedHandle(uint32_t handle) {
+        UnityResolve::Invoke<void>("il2cpp_gchandle_free", handle);
+    }
+
+    ManagedStringCache::ManagedStringCache(size_t setCount)
+            : setCount(std::bit_ceil(setCount)), sets(std::make_unique<Set[]>(this->setCount)) {}
+
+    ManagedStringCache::Il2cppString* ManagedStringCache::Get(std::string_view text, uint64_t generation) {
+        std::lock_guard lock(mutex);
+        if (generation != this->generation) {
+            Clear();
+            this->generation = generation;
+        }
+
+        const auto hash = HashBytes(text.data(), text.size(), 0);
+        auto& set = sets[(hash >> 32) & (setCount - 1)];
+        for (size_t i = 0; i < kWays; i++) {
+            const auto& slot = set.slots[i];
+            // pinned handle 保证对象不会被移动，直接使用保存的指针
+            if (slot.handle && slot.hash == hash &&
+                Utf::Utf8EqualsUtf16(text, {slot.str->chars, static_cast<size_t>(slot.str->length)})) {
+                set.referenced |= static_cast<uint8_t>(1u << i);
+                hits++;
+                return slot.str;
+            }
+        }
+        misses++;
+
+        const auto str = Il2cppString::New(std::string(text));
+        if (!str) return nullptr;
+        const auto handle = PinManagedObject(str);
+        if (handle == 0) return str;
+
+        // 优先空槽，否则按 clock 选择：跳过并清除带引用位的槽
+        size_t victim = kWays;
+        for (size_t i = 0; i < kWays; i++) {
+            if (set.slots[i].handle == 0) {
+                victim = i;
+                break;
+            }
+        }
+        while (victim == kWays) {
+            const size_t i = set.hand++ % kWays;
+            const auto bit = static_cast<uint8_t>(1u << i);
+            if (set.referenced & bit) {
+                set.referenced &= static_cast<uint8_t>(~bit);
+                continue;
+            }
+            victim = i;
+        }
+
+        auto& slot = set.slots[victim];
+        if (slot.handle) ReleaseManagedHandle(slot.handle);
+        slot = {hash, handle, str};
+        set.referenced &= static_cast<uint8_t>(~(1u << victim));
+        return str;
+    }
+
+    void ManagedStringCache::Clear() {
+        size_t released = 0;
+        for (size_t s = 0; s < setCount; s++) {
+            for (auto& slot : sets[s].slots) {
+                if (!slot.handle) continue;
+                ReleaseManagedHandle(slot.handle);
+                slot = {};
+                released++;
+            }
+            sets[s].referenced = 0;
+        }
+        if (released) {
+            Log::DebugFmt("Managed string cache cleared: %zu handles released (%llu hits, %llu misses)", released,
+                          static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses));
+        }
+    }
+
+    UnityResolve::UnityType::String* GetManagedString(std::string_view text) {
+        // 进程退出时不析构，避免在 il2cpp 关闭后释放 handle
+        static auto cache = new ManagedStringCache(1024);
+        return cache->Get(text, GetDataGeneration());
+    }
+}
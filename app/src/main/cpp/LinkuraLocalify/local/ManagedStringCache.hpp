@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../deps/UnityResolve/UnityResolve.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    // 译文 -> 托管字符串。同一条译文反复命中时复用同一个 Il2CppString，避免每次重绘都分配新对象。
+    // 缓存的字符串通过 pinned GC handle 保持存活；4 路组相联，组内 clock 替换，被替换的槽释放其 handle。
+    // 词典快照的版本号变化（重载）时整表清空。handle 的申请和释放都在调用方线程（已附加到 il2cpp）完成。
+    class ManagedStringCache {
+    public:
+        using Il2cppString = UnityResolve::UnityType::String;
+        static constexpr size_t kWays = 4;
+
+        // setCount 会向上取整到 2 的幂
+        explicit ManagedStringCache(size_t setCount);
+
+        ManagedStringCache(const ManagedStringCache&) = delete;
+        ManagedStringCache& operator=(const ManagedStringCache&) = delete;
+
+        // generation 取当前词典快照的版本号
+        Il2cppString* Get(std::string_view text, uint64_t generation);
+
+        [[nodiscard]] uint64_t Hits() const { return hits; }
+        [[nodiscard]] uint64_t Misses() const { return misses; }
+        [[nodiscard]] size_t Capacity() const { return setCount * kWays; }
+
+    private:
+        struct Slot {
+            uint64_t hash = 0;
+            uint32_t handle = 0;  // 0 表示空槽
+            Il2cppString* str = nullptr;
+        };
+        struct Set {
+            Slot slots[kWays]{};
+            uint8_t referenced = 0;
+            uint8_t hand = 0;
+        };
+
+        void Clear();
+
+        const size_t setCount;
+        std::unique_ptr<Set[]> sets;
+        std::mutex mutex{};
+        uint64_t generation = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // 申请 / 释放 pinned GC handle，失败时返回 0
+    uint32_t PinManagedObject(void* obj);
+    void ReleaseManagedHandle(uint32_t handle);
+
+    // 返回内容为 text 的托管字符串，供翻译结果写回游戏对象使用；调用方不得修改返回的字符串
+    UnityResolve::UnityType::String* GetManagedString(std::string_view text);
+}
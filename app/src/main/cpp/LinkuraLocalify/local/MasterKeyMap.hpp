@@ -0,0 +1,146 @@
+#pragma once
+
+#include "FlatStringMap.hpp"
+#include "StringHash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 主表数据的查询键：主键哈希 + 字段路径编号 + 数组下标（不在数组中为 -1）。
+    // 字段路径（name、produceDescriptions|text）在编译规则时编号，不再拼接成字符串
+    struct MasterKey {
+        uint64_t primaryKeyHash = 0;
+        uint32_t pathId = 0;
+        int32_t arrayIndex = -1;
+
+        bool operator==(const MasterKey&) const = default;
+    };
+
+    // 主键由多个字段组成时逐个混入。整数按十进制文本计算，与字符串形式的同一主键结果相同。
+    // 换一个 seed 得到与默认结果相互独立的哈希，可用来校验主键哈希是否碰撞
+    inline uint64_t MixPrimaryKeyPart(uint64_t hash, std::string_view text, uint64_t seed = 0) {
+        const auto part = HashBytes(text.data(), text.size(), seed);
+        return HashBytes(&part, sizeof(part), hash);
+    }
+
+    inline uint64_t MixPrimaryKeyPart(uint64_t hash, int value, uint64_t seed = 0) {
+        char number[16];
+        return MixPrimaryKeyPart(hash, std::string_view(number, std::to_chars(number, number + sizeof(number), value).ptr - number), seed);
+    }
+
+    // 以 MasterKey 为键的开放寻址哈希表，结构与 FlatStringMap 相同，不支持删除。
+    // 键只有 16 字节，不保存任何键字符串；V 为 std::string_view 时可用 EmplaceText 把值存入 arena
+    template <typename V>
+    class MasterKeyMap {
+    public:
+        struct Entry {
+            MasterKey key;
+            V value;
+        };
+
+        MasterKeyMap() = default;
+        MasterKeyMap(MasterKeyMap&&) noexcept = default;
+        MasterKeyMap& operator=(MasterKeyMap&&) noexcept = default;
+        MasterKeyMap(const MasterKeyMap&) = delete;
+        MasterKeyMap& operator=(const MasterKeyMap&) = delete;
+
+        [[nodiscard]] const V* Find(const MasterKey& key) const {
+            const auto index = FindIndex(key, HashKey(key));
+            return index ? &entries[index - 1].value : nullptr;
+        }
+
+        // 键已存在时保留原值，返回 false
+        bool Emplace(const MasterKey& key, V value) {
+            const auto [entry, inserted] = FindOrInsert(key);
+            if (inserted) entry->value = std::move(value);
+            return inserted;
+        }
+
+        bool EmplaceText(const MasterKey& key, std::string_view value) requires std::is_same_v<V, std::string_view> {
+            const auto [entry, inserted] = FindOrInsert(key);
+            if (inserted) entry->value = arena.Store(value);
+            return inserted;
+        }
+
+        // 把值中引用的字符串存入同一个 arena，与表同生命周期
+        std::string_view Store(std::string_view text) {
+            return arena.Store(text);
+        }
+
+        // 加载完成后调用，释放扩容时多出来的空间
+        void ShrinkToFit() {
+            entries.shrink_to_fit();
+            const auto slotCount = entries.empty() ? 0 : std::max<size_t>(16, std::bit_ceil(entries.size() * 2));
+            if (slotCount < slots.size()) {
+                std::vector<uint32_t>(slotCount).swap(slots);
+                for (size_t i = 0; i < entries.size(); i++) {
+                    PlaceSlot(HashKey(entries[i].key), static_cast<uint32_t>(i + 1));
+                }
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return entries.size(); }
+        [[nodiscard]] bool empty() const { return entries.empty(); }
+        [[nodiscard]] auto begin() const { return entries.cbegin(); }
+        [[nodiscard]] auto end() const { return entries.cend(); }
+
+        // 表结构和 arena 占用的字节数，不含值内部的堆内存
+        [[nodiscard]] size_t MemoryBytes() const {
+            return entries.capacity() * sizeof(Entry) + slots.capacity() * sizeof(uint32_t) + arena.ByteSize();
+        }
+
+    private:
+        // 主键哈希已经足够分散，只需再混入路径编号和下标
+        static uint64_t HashKey(const MasterKey& key) {
+            const uint64_t field = (static_cast<uint64_t>(key.pathId) << 32) | static_cast<uint32_t>(key.arrayIndex);
+            const uint64_t h = key.primaryKeyHash ^ (field * 0x9e3779b97f4a7c15ULL);
+            return h ^ (h >> 29);
+        }
+
+        // 返回 entries 下标 + 1，不存在时返回 0
+        [[nodiscard]] uint32_t FindIndex(const MasterKey& key, uint64_t hash) const {
+            if (slots.empty()) return 0;
+            const size_t mask = slots.size() - 1;
+            for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+                const auto slot = slots[i];
+                if (slot == 0) return 0;
+                if (entries[slot - 1].key == key) return slot;
+            }
+        }
+
+        std::pair<Entry*, bool> FindOrInsert(const MasterKey& key) {
+            const auto hash = HashKey(key);
+            if (const auto index = FindIndex(key, hash)) {
+                return {&entries[index - 1], false};
+            }
+            // 负载不超过 1/2
+            if ((entries.size() + 1) * 2 > slots.size()) {
+                slots.assign(std::max<size_t>(16, slots.size() * 2), 0);
+                for (size_t i = 0; i < entries.size(); i++) {
+                    PlaceSlot(HashKey(entries[i].key), static_cast<uint32_t>(i + 1));
+                }
+            }
+            entries.push_back({key, V{}});
+            PlaceSlot(hash, static_cast<uint32_t>(entries.size()));
+            return {&entries.back(), true};
+        }
+
+        void PlaceSlot(uint64_t hash, uint32_t slot) {
+            const size_t mask = slots.size() - 1;
+            size_t i = hash & mask;
+            while (slots[i] != 0) i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+
+        StringArena arena{};
+        std::vector<Entry> entries{};
+        std::vector<uint32_t> slots{};
+    };
+}
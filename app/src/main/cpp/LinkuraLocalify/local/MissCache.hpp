@@ -0,0 +1,84 @@
+#pragma once
+
+#include "StringHash.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    // 记录“确定没有译文”的文本，只保存 64 位指纹。
+    // 4 路组相联，组内用 clock 算法替换：命中时置引用位，替换时跳过并清除带引用位的槽。
+    // 全部操作无锁，并发写入最多导致个别记录丢失或被提前替换，只会多走一次完整查找，不影响正确性。
+    class MissCache {
+    public:
+        static constexpr size_t kWays = 4;
+
+        // setCount 会向上取整到 2 的幂
+        explicit MissCache(size_t setCount)
+                : setCount(std::bit_ceil(setCount)), sets(std::make_unique<Set[]>(this->setCount)) {}
+
+        // seed 取词典快照的版本号，重载后旧指纹自然失效，无需清空
+        static uint64_t Fingerprint(std::string_view text, uint64_t seed) {
+            const auto hash = HashBytes(text.data(), text.size(), seed);
+            return hash == 0 ? 1 : hash;  // 0 表示空槽
+        }
+
+        bool Contains(uint64_t fingerprint) {
+            auto& set = GetSet(fingerprint);
+            for (size_t i = 0; i < kWays; i++) {
+                if (set.slots[i].load(std::memory_order_relaxed) == fingerprint) {
+                    const auto bit = static_cast<uint8_t>(1u << i);
+                    if (!(set.referenced.load(std::memory_order_relaxed) & bit)) {
+                        set.referenced.fetch_or(bit, std::memory_order_relaxed);
+                    }
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        void Insert(uint64_t fingerprint) {
+            auto& set = GetSet(fingerprint);
+            for (auto& slot : set.slots) {
+                uint64_t expected = 0;
+                if (slot.compare_exchange_strong(expected, fingerprint, std::memory_order_relaxed)) return;
+                if (expected == fingerprint) return;
+            }
+            // 最多转两圈：第一圈清除引用位，第二圈必然找到可替换的槽
+            for (size_t n = 0; n < kWays * 2; n++) {
+                const auto i = set.hand.fetch_add(1, std::memory_order_relaxed) % kWays;
+                const auto bit = static_cast<uint8_t>(1u << i);
+                if (set.referenced.fetch_and(static_cast<uint8_t>(~bit), std::memory_order_relaxed) & bit) {
+                    continue;
+                }
+                set.slots[i].store(fingerprint, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        [[nodiscard]] uint64_t Hits() const { return hits.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t Misses() const { return misses.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t Capacity() const { return setCount * kWays; }
+
+    private:
+        struct Set {
+            std::atomic<uint64_t> slots[kWays]{};
+            std::atomic<uint8_t> referenced{0};
+            std::atomic<uint8_t> hand{0};
+        };
+
+        Set& GetSet(uint64_t fingerprint) {
+            return sets[(fingerprint >> 32) & (setCount - 1)];
+        }
+
+        const size_t setCount;
+        std::unique_ptr<Set[]> sets;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 把 [0, count) 分发给若干工作线程执行，调用线程本身也参与，返回时全部完成。
+    // fn 不能抛出异常。
+    template <typename Fn>
+    void ParallelFor(size_t count, Fn&& fn, size_t maxThreads = 0) {
+        if (count == 0) return;
+        size_t threadCount = maxThreads != 0 ? maxThreads : std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::min(threadCount, count);
+
+        std::atomic<size_t> nextIndex{0};
+        auto worker = [&]() {
+            for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+}
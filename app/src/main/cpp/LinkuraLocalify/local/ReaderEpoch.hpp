@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace LinkuraLocal::Local {
+    // 决定被替换的共享数据何时可以释放。读者进入时在当前 epoch 对应的计数上加一，离开时减一；
+    // 写者替换指针后调用 Synchronize，翻转 epoch 并等待旧 epoch 的计数归零，之后不会再有读者持有旧指针。
+    // 读者不加锁、不等待；Synchronize 会阻塞，只能在不处于读区间的线程（加载线程）调用
+    class ReaderEpoch {
+    public:
+        class Guard {
+        public:
+            explicit Guard(std::atomic<uint32_t>& counter) : counter(&counter) {}
+            Guard(Guard&& other) noexcept : counter(std::exchange(other.counter, nullptr)) {}
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+            Guard& operator=(Guard&&) = delete;
+
+            ~Guard() {
+                if (counter) counter->fetch_sub(1, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<uint32_t>* counter;
+        };
+
+        // 在读取共享指针之前调用，Guard 存活期间读到的指针都不会被释放
+        [[nodiscard]] Guard Enter() {
+            for (;;) {
+                const auto current = epoch.load(std::memory_order_seq_cst);
+                auto& counter = readers[current & 1];
+                counter.fetch_add(1, std::memory_order_seq_cst);
+                // 计数加上之前 epoch 已经翻转时重新登记，写者等待的计数才能包含所有可能读到旧指针的读者
+                if (epoch.load(std::memory_order_seq_cst) == current) {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    return Guard(counter);
+                }
+                counter.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // 在新指针发布之后调用，返回时发布前进入的读者都已离开
+        void Synchronize() {
+            std::lock_guard lock(writerMutex);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto previous = epoch.fetch_add(1, std::memory_order_seq_cst);
+            const auto& counter = readers[previous & 1];
+            while (counter.load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+    private:
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint32_t> readers[2]{};
+        std::mutex writerMutex;
+    };
+}
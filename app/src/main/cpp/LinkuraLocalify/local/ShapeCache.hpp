@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    enum class ShapeResolutionKind : uint8_t {
+        Unresolved,  // 无法按形状复用，不写入缓存
+        Fmt,      // genericFmtText 中的模板
+        Regex,    // regexText 中的模板
+        NoMatch,  // fmt 和正则都没有命中，直接进入分割匹配
+    };
+
+    // 文本“形状”（数字等 FLAG 序列替换为 {0}、{1}... 后的文本）对应的模板解析结果
+    struct ShapeResolution {
+        ShapeResolutionKind kind = ShapeResolutionKind::Unresolved;
+        uint64_t hash = 0;
+        std::string shape{};
+        // Fmt: 词典中的译文模板，指向所属快照的词典
+        std::string_view fmtTemplate{};
+        // Regex: 命中的 regexText 下标，以及每个捕获组对应的 FLAG 序号
+        size_t regexIndex = 0;
+        std::vector<uint8_t> captureFlagIndex{};
+    };
+
+    // 形状 -> 解析结果的无锁开放寻址表。只增不删，随所属的词典快照一起释放；
+    // 插入时探测次数或条目数超出上限就直接丢弃，不会影响正确性
+    class ShapeCache {
+    public:
+        static constexpr size_t kMaxProbe = 16;
+
+        // slotCount 会向上取整到 2 的幂，最多存放一半
+        explicit ShapeCache(size_t slotCount)
+                : slotCount(std::bit_ceil(slotCount)), slots(std::make_unique<std::atomic<const ShapeResolution*>[]>(this->slotCount)) {}
+
+        ShapeCache(const ShapeCache&) = delete;
+        ShapeCache& operator=(const ShapeCache&) = delete;
+
+        ~ShapeCache() {
+            for (size_t i = 0; i < slotCount; i++) {
+                delete slots[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] const ShapeResolution* Find(uint64_t hash, std::string_view shape) const {
+            const size_t mask = slotCount - 1;
+            for (size_t n = 0, i = hash & mask; n < kMaxProbe; n++, i = (i + 1) & mask) {
+                const auto resolution = slots[i].load(std::memory_order_acquire);
+                if (!resolution) return nullptr;
+                if (resolution->hash == hash && resolution->shape == shape) return resolution;
+            }
+            return nullptr;
+        }
+
+        void Insert(std::unique_ptr<ShapeResolution> resolution) {
+            if (count.load(std::memory_order_relaxed) >= slotCount / 2) return;
+            const size_t mask = slotCount - 1;
+            for (size_t n = 0, i = resolution->hash & mask; n < kMaxProbe; n++, i = (i + 1) & mask) {
+                const ShapeResolution* expected = nullptr;
+                if (slots[i].compare_exchange_strong(expected, resolution.get(), std::memory_order_release, std::memory_order_acquire)) {
+                    resolution.release();
+                    count.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                // 其它线程已经插入了同一个形状
+                if (expected->hash == resolution->hash && expected->shape == resolution->shape) return;
+            }
+        }
+
+        [[nodiscard]] size_t Size() const { return count.load(std::memory_order_relaxed); }
+
+    private:
+        const size_t slotCount;
+        std::unique_ptr<std::atomic<const ShapeResolution*>[]> slots;
+        std::atomic<size_t> count{0};
+    };
+}
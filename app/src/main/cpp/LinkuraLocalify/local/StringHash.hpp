@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    // MurmurHash64A
+    // 哈希值会写入编译后的词典文件，修改算法时需要同时提升 kCompiledDictVersion
+    inline uint64_t HashBytes(const void* data, size_t len, uint64_t seed = 0) {
+        constexpr uint64_t m = 0xc6a4a7935bd1e995ULL;
+        constexpr int r = 47;
+
+        uint64_t h = seed ^ (len * m);
+        const auto* p = static_cast<const unsigned char*>(data);
+        const auto* end = p + (len & ~static_cast<size_t>(7));
+        for (; p != end; p += 8) {
+            uint64_t k;
+            std::memcpy(&k, p, sizeof(k));
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            h ^= k;
+            h *= m;
+        }
+
+        switch (len & 7) {
+            case 7: h ^= static_cast<uint64_t>(p[6]) << 48; [[fallthrough]];
+            case 6: h ^= static_cast<uint64_t>(p[5]) << 40; [[fallthrough]];
+            case 5: h ^= static_cast<uint64_t>(p[4]) << 32; [[fallthrough]];
+            case 4: h ^= static_cast<uint64_t>(p[3]) << 24; [[fallthrough]];
+            case 3: h ^= static_cast<uint64_t>(p[2]) << 16; [[fallthrough]];
+            case 2: h ^= static_cast<uint64_t>(p[1]) << 8; [[fallthrough]];
+            case 1:
+                h ^= static_cast<uint64_t>(p[0]);
+                h *= m;
+                break;
+            default:
+                break;
+        }
+
+        h ^= h >> r;
+        h *= m;
+        h ^= h >> r;
+        return h;
+    }
+
+    inline uint64_t HashText(std::string_view text) {
+        return HashBytes(text.data(), text.size());
+    }
+
+    // 分段输入的 HashBytes，用于不方便拼出完整数据的场景。总长度需要预先给出，
+    // 各段 Append 的长度之和必须等于 totalLength，结果与对拼接后的数据调用 HashBytes 相同
+    class HashBytesStream {
+    public:
+        explicit HashBytesStream(size_t totalLength, uint64_t seed = 0) : h(seed ^ (totalLength * m)) {}
+
+        void Append(const void* data, size_t len) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            if (pendingLength != 0) {
+                const auto fill = std::min(len, sizeof(pending) - pendingLength);
+                std::memcpy(pending + pendingLength, p, fill);
+                pendingLength += fill;
+                p += fill;
+                len -= fill;
+                if (pendingLength < sizeof(pending)) return;
+                MixBlock(pending);
+                pendingLength = 0;
+            }
+            for (; len >= 8; p += 8, len -= 8) {
+                MixBlock(p);
+            }
+            std::memcpy(pending, p, len);
+            pendingLength = len;
+        }
+
+        void Append(std::string_view text) {
+            Append(text.data(), text.size());
+        }
+
+        [[nodiscard]] uint64_t Finish() const {
+            auto result = h;
+            if (pendingLength != 0) {
+                for (size_t i = pendingLength; i-- > 0;) {
+                    result ^= static_cast<uint64_t>(pending[i]) << (8 * i);
+                }
+                result *= m;
+            }
+            result ^= result >> r;
+            result *= m;
+            result ^= result >> r;
+            return result;
+        }
+
+    private:
+        static constexpr uint64_t m = 0xc6a4a7935bd1e995ULL;
+        static constexpr int r = 47;
+
+        void MixBlock(const unsigned char* p) {
+            uint64_t k;
+            std::memcpy(&k, p, sizeof(k));
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+            h ^= k;
+            h *= m;
+        }
+
+        uint64_t h;
+        unsigned char pending[8]{};
+        size_t pendingLength = 0;
+    };
+}
@@ -0,0 +1,140 @@
+#include "TextClassifier.hpp"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define LINKURA_CLASSIFIER_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LINKURA_CLASSIFIER_SSE2 1
+#endif
+
+namespace LinkuraLocal::Local {
+    namespace {
+        // 字母或非 ASCII 字符
+        inline bool IsWordChar(uint32_t c) {
+            return c >= 0x80 || static_cast<uint32_t>((c | 0x20) - 'a') < 26;
+        }
+
+        inline bool IsSpace(uint32_t c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        inline bool IsDigit(uint32_t c) {
+            return c >= '0' && c <= '9';
+        }
+
+#if defined(LINKURA_CLASSIFIER_NEON)
+        inline bool HasWordChar16(uint8x16_t v) {
+            const uint8x16_t nonAscii = vcgeq_u8(v, vdupq_n_u8(0x80));
+            const uint8x16_t letter = vcltq_u8(vsubq_u8(vorrq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(26));
+            return vmaxvq_u8(vorrq_u8(nonAscii, letter)) != 0;
+        }
+#elif defined(LINKURA_CLASSIFIER_SSE2)
+        // v 中的字节都已确定是 ASCII
+        inline bool HasLetter16(__m128i v) {
+            const __m128i t = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(t, _mm_set1_epi8(-1)), _mm_cmplt_epi8(t, _mm_set1_epi8(26)));
+            return _mm_movemask_epi8(letter) != 0;
+        }
+#endif
+
+        bool HasWordChar(const unsigned char* in, size_t length) {
+            const auto* const end = in + length;
+#if defined(LINKURA_CLASSIFIER_NEON)
+            for (; end - in >= 16; in += 16) {
+                if (HasWordChar16(vld1q_u8(in))) return true;
+            }
+#elif defined(LINKURA_CLASSIFIER_SSE2)
+            for (; end - in >= 16; in += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                if (_mm_movemask_epi8(v) != 0 || HasLetter16(v)) return true;
+            }
+#endif
+            for (; in < end; in++) {
+                if (IsWordChar(*in)) return true;
+            }
+            return false;
+        }
+
+        bool HasWordChar(const char16_t* in, size_t length) {
+            const auto* const end = in + length;
+#if defined(LINKURA_CLASSIFIER_NEON)
+            for (; end - in >= 16; in += 16) {
+                // 饱和收窄后 >= 0x80 的单元仍然 >= 0x80
+                const uint16_t* p = reinterpret_cast<const uint16_t*>(in);
+                if (HasWordChar16(vcombine_u8(vqmovn_u16(vld1q_u16(p)), vqmovn_u16(vld1q_u16(p + 8))))) return true;
+            }
+#elif defined(LINKURA_CLASSIFIER_SSE2)
+            for (; end - in >= 16; in += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+                // packus 按有符号数饱和，先单独判断高位，全是 ASCII 时再收窄
+                const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) return true;
+                if (HasLetter16(_mm_packus_epi16(a, b))) return true;
+            }
+#endif
+            for (; in < end; in++) {
+                if (IsWordChar(*in)) return true;
+            }
+            return false;
+        }
+
+        // 文本中只有数字、ASCII 标点和空白时判断具体格式
+        template <typename Char>
+        TextClass ClassifyAsciiText(const Char* begin, const Char* end) {
+            while (begin < end && IsSpace(begin[0])) begin++;
+            while (begin < end && IsSpace(end[-1])) end--;
+            if (begin == end) return TextClass::Whitespace;
+
+            auto digitRun = [end](const Char* p) {
+                const Char* q = p;
+                while (q < end && IsDigit(*q)) q++;
+                return static_cast<size_t>(q - p);
+            };
+
+            // 1~2 位数字，以 ':' 分隔成 2~3 组
+            size_t groups = 0;
+            for (const Char* p = begin; ; p++) {
+                const auto digits = digitRun(p);
+                if (digits == 0 || digits > 2) break;
+                groups++;
+                p += digits;
+                if (p == end) {
+                    if (groups >= 2 && groups <= 3) return TextClass::Time;
+                    break;
+                }
+                if (*p != ':') break;
+            }
+
+            const Char* p = begin;
+            if (*p == '+' || *p == '-') p++;
+            if (const auto digits = digitRun(p); digits != 0) {
+                p += digits;
+                // 千位分隔符和小数点两侧都必须是数字
+                while (p + 1 < end && (*p == ',' || *p == '.') && IsDigit(p[1])) {
+                    p += 1 + digitRun(p + 1);
+                }
+                if (p == end) return TextClass::Number;
+                if (*p == '%' && p + 1 == end) return TextClass::Percentage;
+                return TextClass::Translatable;
+            }
+
+            for (p = begin; p < end; p++) {
+                if (IsDigit(*p)) return TextClass::Translatable;
+            }
+            return TextClass::Symbols;
+        }
+    }
+
+    TextClass ClassifyText(std::string_view text) {
+        const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+        if (HasWordChar(data, text.size())) return TextClass::Translatable;
+        return ClassifyAsciiText(data, data + text.size());
+    }
+
+    TextClass ClassifyText(std::u16string_view text) {
+        if (HasWordChar(text.data(), text.size())) return TextClass::Translatable;
+        return ClassifyAsciiText(text.data(), text.data() + text.size());
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    // 不需要查词典的文本类型。Translatable 以外的文本直接原样显示
+    enum class TextClass : uint8_t {
+        Translatable,
+        Whitespace,  // 空串或只有空白
+        Number,      // 12、-3、1,234、0.5
+        Time,        // 1:23、12:34、01:23:45
+        Percentage,  // 50%、12.5%
+        Symbols,     // 只有 ASCII 标点和空白
+    };
+
+    // 先用 NEON / SSE2 判断文本中是否有字母或非 ASCII 字符，有则立即返回 Translatable，
+    // 只有全部由数字、标点、空白组成的文本才做进一步的格式判断。不分配内存
+    TextClass ClassifyText(std::string_view text);
+    TextClass ClassifyText(std::u16string_view text);
+}
@@ -0,0 +1,169 @@
+#include "TextDump.hpp"
+#include "MissCache.hpp"
+#include "StringHash.hpp"
+#include "../Local.h"
+#include "../Log.h"
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    namespace {
+        constexpr auto kDumpFlushInterval = std::chrono::seconds(2);
+        // 追加时从文件末尾往回找插入位置的最大字节数
+        constexpr std::streamoff kDumpTailScanSize = 256;
+
+        struct DumpItem {
+            std::string fileName;
+            std::string key;
+            std::string value;
+        };
+        using DumpQueue = MpscQueue<DumpItem>;
+
+        DumpQueue dumpQueue{};
+        // 调用方线程的快速去重，只记录指纹、可能丢失记录；漏过的重复项由写线程按文件中已有的 key 精确去重
+        MissCache recentDumps{4096};
+        std::once_flag writerStarted{};
+
+        // 写线程内某个 dump 文件的状态，首次写入时从磁盘读取一次已有的 key
+        struct DumpFileState {
+            bool loaded = false;
+            bool valid = true;
+            std::unordered_set<std::string> keys{};
+        };
+
+        std::string ToJsonString(const std::string& text) {
+            return nlohmann::json(text).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+        }
+
+        void LoadDumpFileState(const std::filesystem::path& path, DumpFileState& state) {
+            state.loaded = true;
+            if (!std::filesystem::exists(path)) return;
+            try {
+                std::ifstream file(path);
+                const auto data = nlohmann::ordered_json::parse(file);
+                for (const auto& [key, value] : data.items()) {
+                    state.keys.emplace(key);
+                }
+            }
+            catch (std::exception& e) {
+                // 无法解析的文件不再追加，避免写坏
+                state.valid = false;
+                Log::ErrorFmt("Load dump file %s failed: %s", path.c_str(), e.what());
+            }
+        }
+
+        // 找到 JSON 对象最后一个 '}' 之前最后一个非空白字符，返回其后的偏移；失败时返回 -1
+        std::streamoff FindAppendOffset(std::fstream& file, bool* hasEntries) {
+            file.seekg(0, std::ios::end);
+            const std::streamoff size = file.tellg();
+            const auto scanSize = std::min(size, kDumpTailScanSize);
+            std::string tail(static_cast<size_t>(scanSize), '\0');
+            file.seekg(size - scanSize);
+            file.read(tail.data(), scanSize);
+
+            const auto closing = tail.find_last_of('}');
+            if (closing == std::string::npos) return -1;
+            const auto last = tail.find_last_not_of(" \t\r\n", closing == 0 ? std::string::npos : closing - 1);
+            if (closing == 0 || last == std::string::npos) return -1;
+            *hasEntries = tail[last] != '{';
+            return size - scanSize + static_cast<std::streamoff>(last) + 1;
+        }
+
+        // 在对象末尾追加新条目，格式与 ordered_json::dump(4) 一致
+        void AppendDumpEntries(const std::filesystem::path& path, DumpFileState& state, const std::vector<const DumpItem*>& items) {
+            std::string segment;
+            size_t added = 0;
+            for (const auto item : items) {
+                if (!state.keys.emplace(item->key).second) continue;
+                segment.append(added == 0 ? "\n    " : ",\n    ");
+                segment.append(ToJsonString(item->key));
+                segment.append(": ");
+                segment.append(ToJsonString(item->value));
+                added++;
+            }
+            if (added == 0) return;
+            segment.append("\n}");
+
+            if (!std::filesystem::exists(path)) {
+                std::ofstream file(path, std::ios::binary);
+                file << '{' << segment;
+            }
+            else {
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                bool hasEntries = false;
+                const auto offset = FindAppendOffset(file, &hasEntries);
+                if (offset < 0) {
+                    state.valid = false;
+                    Log::ErrorFmt("Dump file %s is not a JSON object, skipped.", path.c_str());
+                    return;
+                }
+                file.seekp(offset);
+                if (hasEntries) file.put(',');
+                file.write(segment.data(), static_cast<std::streamsize>(segment.size()));
+                file.close();
+                // 原文件 '}' 之后可能还有空白，截掉多余部分
+                std::filesystem::resize_file(path, offset + (hasEntries ? 1 : 0) + segment.size());
+            }
+            Log::DebugFmt("Dumped %zu entries to %s", added, path.filename().c_str());
+        }
+
+        void DumpWriterLoop() {
+            const auto dumpBasePath = GetBasePath() / "dump-files";
+            std::unordered_map<std::string, DumpFileState> files{};
+
+            while (true) {
+                std::this_thread::sleep_for(kDumpFlushInterval);
+
+                std::vector<std::unique_ptr<DumpQueue::Node>> batch;
+                while (const auto node = dumpQueue.Pop()) {
+                    batch.emplace_back(node);
+                }
+                if (batch.empty()) continue;
+
+                // 按文件分组，组内保持入队顺序
+                std::unordered_map<std::string, std::vector<const DumpItem*>> groups{};
+                for (const auto& node : batch) {
+                    groups[node->value.fileName].push_back(&node->value);
+                }
+
+                try {
+                    if (!std::filesystem::is_directory(dumpBasePath)) {
+                        std::filesystem::create_directories(dumpBasePath);
+                    }
+                    for (const auto& [fileName, items] : groups) {
+                        const auto path = dumpBasePath / fileName;
+                        auto& state = files[fileName];
+                        if (!state.loaded) LoadDumpFileState(path, state);
+                        if (!state.valid) continue;
+                        AppendDumpEntries(path, state, items);
+                    }
+                }
+                catch (std::exception& e) {
+                    Log::ErrorFmt("Write dump files failed: %s", e.what());
+                }
+            }
+        }
+    }
+
+    void EnqueueTextDump(const std::filesystem::path& fileName, const std::string& key, const std::string& value) {
+        const auto& name = fileName.native();
+        const auto fingerprint = MissCache::Fingerprint(key, HashBytes(name.data(), name.size()));
+        if (recentDumps.Contains(fingerprint)) return;
+        recentDumps.Insert(fingerprint);
+
+        std::call_once(writerStarted, [] {
+            std::thread(DumpWriterLoop).detach();
+        });
+        const auto node = new DumpQueue::Node();
+        node->value = {fileName.string(), key, value};
+        dumpQueue.Push(node);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+
+namespace LinkuraLocal::Local {
+    // 多生产者单消费者无锁队列（Vyukov）。Push 只有一次 exchange，可在任意线程调用；Pop 只能由单个消费者调用。
+    // 节点由调用方分配，出队后归消费者所有
+    template <typename T>
+    class MpscQueue {
+    public:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            T value{};
+        };
+
+        MpscQueue() : head(&stub), tail(&stub) {}
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        void Push(Node* node) {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            const auto prev = head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // 队列为空，或生产者刚交换完 head 还没链接上时返回 nullptr，稍后重试即可
+        Node* Pop() {
+            auto current = tail;
+            auto next = current->next.load(std::memory_order_acquire);
+            if (current == &stub) {
+                if (!next) return nullptr;
+                tail = next;
+                current = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next) {
+                tail = next;
+                return current;
+            }
+            if (current != head.load(std::memory_order_acquire)) return nullptr;
+            // current 是最后一个节点：重新放入 stub 后才能把它取出
+            Push(&stub);
+            next = current->next.load(std::memory_order_acquire);
+            if (next) {
+                tail = next;
+                return current;
+            }
+            return nullptr;
+        }
+
+    private:
+        std::atomic<Node*> head;
+        Node* tail;
+        Node stub{};
+    };
+
+    // dump-files 目录下的文本导出。调用方线程只做指纹去重和入队，
+    // 由唯一的写线程定期批量追加到 JSON 文件末尾，不再重写整个文件
+    void EnqueueTextDump(const std::filesystem::path& fileName, const std::string& key, const std::string& value);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ManagedStringCache.hpp"
+#include "StringHash.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace LinkuraLocal::Local {
+    enum class TextHookKind : uint8_t {
+        PopulateTextBackingArray,
+        SetText,
+    };
+
+    struct TextMemoKey {
+        void* component = nullptr;
+        const UnityResolve::UnityType::String* source = nullptr;
+        int start = 0;
+        int length = 0;
+        uint64_t sourceHash = 0;
+        uint64_t generation = 0;
+        TextHookKind kind = TextHookKind::PopulateTextBackingArray;
+
+        bool operator==(const TextMemoKey&) const = default;
+    };
+
+    // 每个文本组件在每个 hook 上最近一次的输入和输出。UI 重绘时同一组件反复传入同一个字符串，
+    // 命中时直接重放上次的结果，跳过整个翻译查找（字体检查仍在查询前进行）。
+    // 直接映射、冲突时覆盖；组件销毁时由 OnDestroy hook 调用 Evict 清除。仅在主线程访问。
+    class TextMemo {
+    public:
+        using Il2cppString = UnityResolve::UnityType::String;
+
+        // slotCount 会向上取整到 2 的幂
+        explicit TextMemo(size_t slotCount)
+                : slotCount(std::bit_ceil(slotCount)), slots(std::make_unique<Slot[]>(this->slotCount)) {}
+
+        TextMemo(const TextMemo&) = delete;
+        TextMemo& operator=(const TextMemo&) = delete;
+
+        static TextMemoKey MakeKey(void* component, TextHookKind kind, const Il2cppString* source, int start, int length, uint64_t generation) {
+            const std::u16string_view text(source->chars + start, static_cast<size_t>(length));
+            return {component, source, start, length, HashBytes(text.data(), text.size() * sizeof(char16_t)), generation, kind};
+        }
+
+        // 命中时返回 true，*result 为上次写入的译文，nullptr 表示上次没有译文、原样传递
+        bool Find(const TextMemoKey& key, Il2cppString** result) {
+            const auto& slot = GetSlot(key.component, key.kind);
+            if (slot.used && slot.key == key) {
+                hits++;
+                *result = slot.result;
+                return true;
+            }
+            misses++;
+            return false;
+        }
+
+        // result 为 nullptr 表示没有译文
+        void Store(const TextMemoKey& key, Il2cppString* result) {
+            auto& slot = GetSlot(key.component, key.kind);
+            Release(slot);
+            if (result) {
+                // 译文字符串只由本表引用时也要保证存活
+                slot.resultHandle = PinManagedObject(result);
+                if (slot.resultHandle == 0) return;
+            }
+            slot.key = key;
+            slot.result = result;
+            slot.used = true;
+        }
+
+        void Evict(void* component) {
+            for (const auto kind : {TextHookKind::PopulateTextBackingArray, TextHookKind::SetText}) {
+                auto& slot = GetSlot(component, kind);
+                if (slot.used && slot.key.component == component) {
+                    Release(slot);
+                    evictions++;
+                }
+            }
+        }
+
+        [[nodiscard]] uint64_t Hits() const { return hits; }
+        [[nodiscard]] uint64_t Misses() const { return misses; }
+        [[nodiscard]] uint64_t Evictions() const { return evictions; }
+        [[nodiscard]] double HitRate() const {
+            const auto total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+
+    private:
+        struct Slot {
+            TextMemoKey key{};
+            Il2cppString* result = nullptr;
+            uint32_t resultHandle = 0;
+            bool used = false;
+        };
+
+        Slot& GetSlot(void* component, TextHookKind kind) {
+            const uint64_t id = reinterpret_cast<uintptr_t>(component) ^ static_cast<uint64_t>(kind);
+            return slots[HashBytes(&id, sizeof(id)) & (slotCount - 1)];
+        }
+
+        static void Release(Slot& slot) {
+            if (slot.resultHandle) ReleaseManagedHandle(slot.resultHandle);
+            slot = {};
+        }
+
+        const size_t slotCount;
+        std::unique_ptr<Slot[]> slots;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LinkuraLocal::Local {
+    // 正则模板的译文预先拆成字面文本和占位符两种片段，命中时按顺序拼接，不再做任何正则替换。
+    // 占位符为 {N} 或 {N:fX}/{N:FX}（X 为可选的数字），N 为捕获组序号；没有对应捕获组的占位符原样输出
+    class TranslationTemplate {
+    public:
+        TranslationTemplate() = default;
+
+        explicit TranslationTemplate(std::string_view text) {
+            size_t literalStart = 0;
+            size_t pos = 0;
+            while ((pos = text.find('{', pos)) != std::string_view::npos) {
+                uint32_t captureIndex = 0;
+                const auto length = MatchPlaceholder(text, pos, &captureIndex);
+                if (length == 0) {
+                    pos++;
+                    continue;
+                }
+                if (pos > literalStart) {
+                    segments.push_back({static_cast<uint32_t>(literalStart), static_cast<uint32_t>(pos - literalStart), kLiteral});
+                }
+                segments.push_back({static_cast<uint32_t>(pos), static_cast<uint32_t>(length), captureIndex});
+                pos += length;
+                literalStart = pos;
+            }
+            if (literalStart < text.size()) {
+                segments.push_back({static_cast<uint32_t>(literalStart), static_cast<uint32_t>(text.size() - literalStart), kLiteral});
+            }
+        }
+
+        // text 必须是构造时传入的同一段文本
+        void Render(std::string_view text, std::span<const std::string_view> captures, std::string* out) const {
+            size_t size = 0;
+            for (const auto& segment : segments) {
+                size += segment.captureIndex < captures.size() ? captures[segment.captureIndex].size() : segment.length;
+            }
+            out->clear();
+            out->reserve(size);
+            for (const auto& segment : segments) {
+                if (segment.captureIndex < captures.size()) {
+                    out->append(captures[segment.captureIndex]);
+                }
+                else {
+                    out->append(text.substr(segment.offset, segment.length));
+                }
+            }
+        }
+
+    private:
+        static constexpr uint32_t kLiteral = UINT32_MAX;
+        // 序号最多 9 位，避免溢出
+        static constexpr size_t kMaxIndexDigits = 9;
+
+        struct Segment {
+            uint32_t offset;
+            uint32_t length;
+            uint32_t captureIndex;  // kLiteral 表示字面文本
+        };
+
+        static bool IsDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        // 匹配 text[pos] 处的占位符，返回其长度，不是占位符时返回 0
+        static size_t MatchPlaceholder(std::string_view text, size_t pos, uint32_t* captureIndex) {
+            size_t i = pos + 1;
+            const size_t digitsStart = i;
+            uint32_t index = 0;
+            while (i < text.size() && IsDigit(text[i])) {
+                index = index * 10 + (text[i] - '0');
+                i++;
+            }
+            const auto digits = i - digitsStart;
+            // 与 "{N}" 精确匹配，不接受前导零
+            if (digits == 0 || digits > kMaxIndexDigits || (digits > 1 && text[digitsStart] == '0')) return 0;
+            if (i + 1 < text.size() && text[i] == ':' && (text[i + 1] == 'f' || text[i + 1] == 'F')) {
+                i += 2;
+                while (i < text.size() && IsDigit(text[i])) i++;
+            }
+            if (i >= text.size() || text[i] != '}') return 0;
+            *captureIndex = index;
+            return i + 1 - pos;
+        }
+
+        std::vector<Segment> segments{};
+    };
+}
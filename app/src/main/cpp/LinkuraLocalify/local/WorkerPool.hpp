@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace LinkuraLocal::Local {
+    // 常驻的工作线程池，第一次使用时启动，之后一直存在。与 ParallelFor 不同，
+    // 每次调用不创建线程，适合在钩子里频繁执行的小批量任务。
+    // 同一时间只执行一个任务；池正被占用时调用线程自己完成全部工作，不等待。
+    class WorkerPool {
+    public:
+        static WorkerPool& Instance() {
+            // 不析构：工作线程在进程退出前一直等待任务
+            static auto pool = new WorkerPool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+            return *pool;
+        }
+
+        // 把 [0, count) 分发给池中的线程，调用线程本身也参与，返回时全部完成。fn 不能抛出异常
+        template <typename Fn>
+        void Run(size_t count, Fn&& fn) {
+            if (count == 0) return;
+            Job job{
+                    .count = count,
+                    .invoke = [](void* context, size_t i) { (*static_cast<std::remove_reference_t<Fn>*>(context))(i); },
+                    .context = const_cast<void*>(static_cast<const void*>(std::addressof(fn))),
+            };
+            std::unique_lock runLock(runMutex, std::try_to_lock);
+            if (count == 1 || threadCount == 0 || !runLock.owns_lock()) {
+                Work(job);
+                return;
+            }
+
+            {
+                std::lock_guard lock(mutex);
+                currentJob = &job;
+                jobSerial++;
+            }
+            jobReady.notify_all();
+            Work(job);
+
+            // 不再让新的线程领取，等已经领取的线程做完；job 在栈上，之后不能再被访问
+            std::unique_lock lock(mutex);
+            currentJob = nullptr;
+            jobDone.wait(lock, [&job] { return job.activeWorkers == 0; });
+        }
+
+    private:
+        struct Job {
+            size_t count;
+            void (*invoke)(void* context, size_t i);
+            void* context;
+            std::atomic<size_t> nextIndex{0};
+            size_t activeWorkers = 0;  // 在 mutex 下访问
+        };
+
+        explicit WorkerPool(size_t threadCount) : threadCount(threadCount) {
+            for (size_t i = 0; i < threadCount; i++) {
+                std::thread([this] { WorkerLoop(); }).detach();
+            }
+        }
+
+        static void Work(Job& job) {
+            for (size_t i = job.nextIndex.fetch_add(1); i < job.count; i = job.nextIndex.fetch_add(1)) {
+                job.invoke(job.context, i);
+            }
+        }
+
+        void WorkerLoop() {
+            uint64_t seenSerial = 0;
+            std::unique_lock lock(mutex);
+            for (;;) {
+                jobReady.wait(lock, [&] { return jobSerial != seenSerial; });
+                seenSerial = jobSerial;
+                const auto job = currentJob;
+                if (!job) continue;
+                job->activeWorkers++;
+                lock.unlock();
+                Work(*job);
+                lock.lock();
+                if (--job->activeWorkers == 0) jobDone.notify_all();
+            }
+        }
+
+        const size_t threadCount;
+        std::mutex runMutex;
+        std::mutex mutex;
+        std::condition_variable jobReady;
+        std::condition_variable jobDone;
+        Job* currentJob = nullptr;
+        uint64_t jobSerial = 0;
+    };
+}
@@ -1,118 +1,144 @@
-#include <unordered_set>
+#include <charconv>
+#include <iterator>
 #include "StringParser.hpp"
+#include "TextTokenizer.hpp"
 #include "fmt/core.h"
-#include "fmt/ranges.h"
-#include "../Misc.hpp"
+#include "fmt/args.h"
+#include "../local/StringHash.hpp"
 
 namespace StringParser {
+    namespace {
+        // 与 Misc::StringFormat::stringFormat 支持的参数个数一致
+        constexpr size_t kMaxFormatArgs = 24;
 
-    std::string ParseItems::ToFmtString() {
-        std::vector<std::string> ret{};
-        int currFlagIndex = 0;
-        for (const auto& i : items) {
-            if (i.type == ParseItemType::FLAG) {
-                ret.push_back(fmt::format("{{{}}}", currFlagIndex));
-                currFlagIndex++;
-            }
-            else {
-                ret.push_back(i.content);
+        // 写入 "{index}"，返回长度
+        size_t WritePlaceholder(char (&buf)[24], size_t index) {
+            buf[0] = '{';
+            const auto end = std::to_chars(buf + 1, buf + sizeof(buf) - 1, index).ptr;
+            *end = '}';
+            return static_cast<size_t>(end - buf) + 1;
+        }
+
+        // 按 fmt 文本的顺序依次回调每一段
+        template <typename Fn>
+        void ForEachShapePart(const ParseItems& parseItems, Fn&& fn) {
+            char placeholder[24];
+            size_t flagIndex = 0;
+            for (const auto& i : parseItems.items) {
+                if (i.type == ParseItemType::FLAG) {
+                    fn(std::string_view(placeholder, WritePlaceholder(placeholder, flagIndex++)));
+                }
+                else {
+                    fn(parseItems.Content(i));
+                }
             }
         }
-        return fmt::format("{}", fmt::join(ret, ""));
     }
 
-    std::vector<std::string> ParseItems::GetFlagValues() {
-        std::vector<std::string> ret{};
+    size_t ParseItems::FmtStringSize() const {
+        size_t size = 0;
+        ForEachShapePart(*this, [&](std::string_view part) { size += part.size(); });
+        return size;
+    }
+
+    void ParseItems::AppendFmtString(std::string* out) const {
+        out->reserve(out->size() + FmtStringSize());
+        ForEachShapePart(*this, [&](std::string_view part) { out->append(part); });
+    }
+
+    std::string ParseItems::ToFmtString() const {
+        std::string ret;
+        AppendFmtString(&ret);
+        return ret;
+    }
+
+    uint64_t ParseItems::ShapeHash() const {
+        LinkuraLocal::Local::HashBytesStream hash(FmtStringSize());
+        ForEachShapePart(*this, [&](std::string_view part) { hash.Append(part); });
+        return hash.Finish();
+    }
+
+    bool ParseItems::ShapeEquals(std::string_view shape) const {
+        size_t pos = 0;
+        bool equals = true;
+        ForEachShapePart(*this, [&](std::string_view part) {
+            if (!equals) return;
+            equals = shape.substr(pos, part.size()) == part;
+            pos += part.size();
+        });
+        return equals && pos == shape.size();
+    }
+
+    void ParseItems::GetFlagValues(std::vector<std::string_view>* values) const {
+        values->clear();
         for (const auto& i : items) {
             if (i.type == ParseItemType::FLAG) {
-                ret.push_back(i.content);
+                values->push_back(Content(i));
             }
         }
-        return ret;
     }
 
-    ParseItems ParseItems::parse(const std::string &str, bool parseTags) {
-        static const std::unordered_set<char16_t> splitFlags = {u'0', u'1', u'2', u'3', u'4', u'5',
-                                                                u'6', u'7', u'8', u'9', u'+', u'＋',
-                                                                u'-', u'－', u'%', u'％',
-                                                                u'.', u'×', u',', u'，'};
-
+    ParseItems ParseItems::parse(std::string_view str, bool parseTags) {
         ParseItems result;
-        if (str.contains("{")) {
+        result.source = str;
+        if (str.contains('{')) {
             result.isValid = false;
             return result;
         }
-        std::u16string origText = LinkuraLocal::Misc::ToUTF16(str);
-        bool isInTag = false;
-        bool isInFlagSequence = false;
-        std::u16string currentCacheText;
-
-        for (char16_t currChar : origText) {
-            if (parseTags && currChar == u'<') {
-                if (!currentCacheText.empty()) {
-                    result.items.push_back({isInFlagSequence ? ParseItemType::FLAG : ParseItemType::TEXT,
-                                            LinkuraLocal::Misc::ToUTF8(currentCacheText)});
-                    currentCacheText.clear();
-                    isInFlagSequence = false;
-                }
-                isInTag = true;
-                currentCacheText.push_back(currChar);
-            } else if (parseTags && currChar == u'>') {
-                isInTag = false;
-                currentCacheText.push_back(currChar);
-                result.items.push_back({ParseItemType::FLAG, LinkuraLocal::Misc::ToUTF8(currentCacheText)});
-                currentCacheText.clear();
-            } else if (isInTag) {
-                currentCacheText.push_back(currChar);
-            } else if (splitFlags.contains(currChar)) {
-                if (!isInFlagSequence && !currentCacheText.empty()) {
-                    result.items.push_back({ParseItemType::TEXT, LinkuraLocal::Misc::ToUTF8(currentCacheText)});
-                    currentCacheText.clear();
+
+        TextTokenizer tokenizer(str, kFmtFlags, parseTags);
+        bool lastWasTag = true;
+        bool hasFlag = false;
+        for (Token token; tokenizer.Next(&token);) {
+            ParseItem item{ParseItemType::TEXT, static_cast<uint32_t>(token.offset), static_cast<uint32_t>(token.text.size())};
+            if (token.type == TokenType::Tag) {
+                if (token.text == ">" && !lastWasTag && !result.items.empty()) {
+                    // 标签外的 '>' 与前面一段合并为 FLAG
+                    result.items.back().type = ParseItemType::FLAG;
+                    result.items.back().length++;
+                    hasFlag = true;
                 }
-                isInFlagSequence = true;
-                currentCacheText.push_back(currChar);
-            } else {
-                if (isInFlagSequence && !currentCacheText.empty()) {
-                    result.items.push_back({ParseItemType::FLAG, LinkuraLocal::Misc::ToUTF8(currentCacheText)});
-                    currentCacheText.clear();
-                    isInFlagSequence = false;
+                else {
+                    // 未闭合的标签按文本处理
+                    if (token.text.ends_with('>')) {
+                        item.type = ParseItemType::FLAG;
+                        hasFlag = true;
+                    }
+                    result.items.push_back(item);
                 }
-                currentCacheText.push_back(currChar);
+                lastWasTag = true;
+                continue;
             }
-        }
-
-        if (!currentCacheText.empty()) {
-            result.items.push_back({isInFlagSequence ? ParseItemType::FLAG : ParseItemType::TEXT,
-                                    LinkuraLocal::Misc::ToUTF8(currentCacheText)});
-        }
-
-        for (auto& i : result.items) {
-            if (i.type == ParseItemType::FLAG) {
-                return result;
+            if (token.type == TokenType::Flag) {
+                item.type = ParseItemType::FLAG;
+                hasFlag = true;
             }
+            result.items.push_back(item);
+            lastWasTag = false;
         }
-        result.isValid = false;
+
+        result.isValid = hasFlag;
         return result;
     }
 
-    std::string ParseItems::MergeText(ParseItems &textTarget, ParseItems &valueTarget) {
+    std::string ParseItems::MergeText(const ParseItems& textTarget, const ParseItems& valueTarget) {
         if (!textTarget.isValid) return "";
         if (!valueTarget.isValid) return "";
-        const auto fmtText = textTarget.ToFmtString();
-        const auto values = valueTarget.GetFlagValues();
-        const std::string ret = LinkuraLocal::Misc::StringFormat::stringFormatString(fmtText, values);
-        return {ret.begin(), ret.end()};
+        return valueTarget.MergeText(textTarget.ToFmtString());
     }
 
-    std::string ParseItems::MergeText(const std::string &newStr) {
+    std::string ParseItems::MergeText(std::string_view newStr) const {
         if (!isValid) return "";
-        const auto values = GetFlagValues();
-        return LinkuraLocal::Misc::StringFormat::stringFormatString(newStr, values);
+        thread_local std::vector<std::string_view> values;
+        GetFlagValues(&values);
+        std::string ret;
+        AppendFormatted(newStr, values, &ret);
+        return ret;
     }
 
-    int ParseItems::GetFlagCount() {
+    int ParseItems::GetFlagCount() const {
         int ret = 0;
-        for (auto& i : items) {
+        for (const auto& i : items) {
             if (i.type == ParseItemType::FLAG) {
                 ret++;
             }
@@ -120,4 +146,54 @@ namespace StringParser {
         return ret;
     }
 
+    void AppendFormatted(std::string_view fmtTemplate, std::span<const std::string_view> values, std::string* out) {
+        if (values.empty() || values.size() > kMaxFormatArgs) {
+            out->append(fmtTemplate);
+            return;
+        }
+        // string_view 参数只记录引用，不复制内容
+        thread_local fmt::dynamic_format_arg_store<fmt::format_context> args;
+        args.clear();
+        size_t valuesSize = 0;
+        for (const auto value : values) {
+            args.push_back(value);
+            valuesSize += value.size();
+        }
+
+        const auto start = out->size();
+        out->reserve(start + fmtTemplate.size() + valuesSize);
+        try {
+            fmt::vformat_to(std::back_inserter(*out), fmtTemplate, args);
+        }
+        catch (std::exception& e) {
+            out->resize(start);
+            out->append(fmtTemplate);
+        }
+    }
+
+    bool BuildFmtShape(std::string_view str, std::string* shape, std::vector<std::string_view>* flagValues) {
+        shape->clear();
+        flagValues->clear();
+        if (str.find('{') != std::string_view::npos) return false;
+
+        TextTokenizer tokenizer(str, kFmtFlags, false);
+        for (Token token; tokenizer.Next(&token);) {
+            if (token.type == TokenType::Flag) {
+                fmt::format_to(std::back_inserter(*shape), "{{{}}}", flagValues->size());
+                flagValues->push_back(token.text);
+            }
+            else {
+                shape->append(token.text);
+            }
+        }
+        return !flagValues->empty();
+    }
+
+    bool ContainsFlagChar(std::string_view str) {
+        for (size_t pos = 0; pos < str.size(); pos++) {
+            if (kFmtFlags.CharLength(str, pos) != 0) return true;
+        }
+        return false;
+    }
+
 }
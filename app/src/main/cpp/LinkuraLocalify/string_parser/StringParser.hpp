@@ -1,30 +1,105 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace StringParser {
-    enum class ParseItemType {
+    enum class ParseItemType : uint8_t {
         FLAG,
         TEXT
     };
 
+    // 原文中的一段，不持有内容
     struct ParseItem {
         ParseItemType type;
-        std::string content;
+        uint32_t offset;  // 在 ParseItems::source 中的字节偏移
+        uint32_t length;
     };
 
+    // 不超过 N 项时存放在对象内部，超出后整体搬到堆上。只用于可平凡复制的类型
+    template <typename T, size_t N>
+    class InlineVector {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    public:
+        void push_back(const T& value) {
+            if (count < N) {
+                inlineItems[count++] = value;
+                return;
+            }
+            if (count == N) {
+                heapItems.assign(inlineItems.begin(), inlineItems.end());
+            }
+            heapItems.push_back(value);
+            count++;
+        }
+
+        void clear() {
+            count = 0;
+            heapItems.clear();
+        }
+
+        [[nodiscard]] size_t size() const { return count; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+
+        T* data() { return count <= N ? inlineItems.data() : heapItems.data(); }
+        const T* data() const { return count <= N ? inlineItems.data() : heapItems.data(); }
+        T* begin() { return data(); }
+        T* end() { return data() + count; }
+        const T* begin() const { return data(); }
+        const T* end() const { return data() + count; }
+        T& back() { return data()[count - 1]; }
+        T& operator[](size_t index) { return data()[index]; }
+        const T& operator[](size_t index) const { return data()[index]; }
+
+    private:
+        std::array<T, N> inlineItems{};
+        std::vector<T> heapItems{};
+        size_t count = 0;
+    };
+
+    // fmt 模板的切分结果。各项只记录在 source 中的位置，parse 的参数需要在使用期间保持有效
     struct ParseItems {
         bool isValid = true;
-        std::vector<ParseItem> items;
+        std::string_view source{};
+        InlineVector<ParseItem, 16> items{};
+
+        [[nodiscard]] std::string_view Content(const ParseItem& item) const {
+            return source.substr(item.offset, item.length);
+        }
+
+        // 把每段 FLAG 替换成 {0}、{1}... 后的文本
+        [[nodiscard]] std::string ToFmtString() const;
+        void AppendFmtString(std::string* out) const;
+        [[nodiscard]] size_t FmtStringSize() const;
+        // 等于 HashText(ToFmtString())，不生成 fmt 文本
+        [[nodiscard]] uint64_t ShapeHash() const;
+        // 等于 ToFmtString() == shape，不生成 fmt 文本
+        [[nodiscard]] bool ShapeEquals(std::string_view shape) const;
 
-        std::string ToFmtString();
-        std::vector<std::string> GetFlagValues();
-        std::string MergeText(const std::string& newStr);
-        int GetFlagCount();
+        void GetFlagValues(std::vector<std::string_view>* values) const;
+        // 用各段 FLAG 填充 newStr 模板，无效时返回空字符串
+        [[nodiscard]] std::string MergeText(std::string_view newStr) const;
+        [[nodiscard]] int GetFlagCount() const;
 
-        static ParseItems parse(const std::string& str, bool parseTags);
-        static std::string MergeText(ParseItems& textTarget, ParseItems& valueTarget);
+        static ParseItems parse(std::string_view str, bool parseTags);
+        static std::string MergeText(const ParseItems& textTarget, const ParseItems& valueTarget);
     };
 
+    // 按 fmt 语法用 values 填充 fmtTemplate 并追加到 out；参数个数不支持或模板与参数不匹配时追加模板原文，
+    // 与 Misc::StringFormat::stringFormatString 的行为一致
+    void AppendFormatted(std::string_view fmtTemplate, std::span<const std::string_view> values, std::string* out);
+
+    // 与 parse(str, false) 使用相同的 FLAG 字符集，但直接在 UTF-8 上扫描，不做 UTF-16 转换。
+    // shape 为把每段 FLAG 替换成 {0}、{1}... 后的文本，与 parse(str, false).ToFmtString() 一致；
+    // flagValues 为各段 FLAG 在 str 中的位置。str 含 '{' 或不含 FLAG 时返回 false
+    bool BuildFmtShape(std::string_view str, std::string* shape, std::vector<std::string_view>* flagValues);
+    bool ContainsFlagChar(std::string_view str);
+
 }
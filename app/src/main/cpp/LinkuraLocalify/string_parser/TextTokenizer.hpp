@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace StringParser {
+    // 一组 FLAG 字符（数字、符号等）。每个字节先查 256 项分类表，只有可能是非 ASCII FLAG 字符首字节时才解码比较
+    class FlagSet {
+    public:
+        static constexpr uint8_t kAsciiFlag = 1;
+        static constexpr uint8_t kWideLead = 2;
+        static constexpr uint8_t kTagChar = 4;  // '<' 和 '>'，由分词器决定是否处理
+
+        consteval explicit FlagSet(std::u16string_view chars) {
+            byteClass['<'] = kTagChar;
+            byteClass['>'] = kTagChar;
+            for (const auto c : chars) {
+                if (c < 0x80) {
+                    byteClass[c] |= kAsciiFlag;
+                }
+                else {
+                    wide[wideCount++] = c;
+                    byteClass[c < 0x800 ? 0xC0 | (c >> 6) : 0xE0 | (c >> 12)] |= kWideLead;
+                }
+            }
+        }
+
+        [[nodiscard]] constexpr uint8_t ByteClass(char c) const {
+            return byteClass[static_cast<unsigned char>(c)];
+        }
+
+        // str[pos] 起始的字符属于本集合时返回其 UTF-8 字节数，否则返回 0
+        [[nodiscard]] constexpr size_t CharLength(std::string_view str, size_t pos) const {
+            const auto c0 = static_cast<unsigned char>(str[pos]);
+            const auto cls = byteClass[c0];
+            if (cls & kAsciiFlag) return 1;
+            if (!(cls & kWideLead)) return 0;
+            char16_t c;
+            size_t length;
+            if (c0 < 0xE0) {
+                if (pos + 1 >= str.size()) return 0;
+                c = static_cast<char16_t>(((c0 & 0x1F) << 6) | (static_cast<unsigned char>(str[pos + 1]) & 0x3F));
+                length = 2;
+            }
+            else {
+                if (pos + 2 >= str.size()) return 0;
+                c = static_cast<char16_t>(((c0 & 0x0F) << 12) | ((static_cast<unsigned char>(str[pos + 1]) & 0x3F) << 6) |
+                                          (static_cast<unsigned char>(str[pos + 2]) & 0x3F));
+                length = 3;
+            }
+            for (size_t i = 0; i < wideCount; i++) {
+                if (wide[i] == c) return length;
+            }
+            return 0;
+        }
+
+    private:
+        std::array<uint8_t, 256> byteClass{};
+        std::array<char16_t, 8> wide{};
+        size_t wideCount = 0;
+    };
+
+    // 分割匹配（GetSplitTagsTranslationFull）使用的 FLAG 字符
+    inline constexpr FlagSet kSplitFlags{u"0123456789+＋-－%％【】.:：×"};
+    // fmt 模板（ParseItems::parse、BuildFmtShape）使用的 FLAG 字符
+    inline constexpr FlagSet kFmtFlags{u"0123456789+＋-－%％.×,，"};
+
+    enum class TokenType : uint8_t {
+        Tag,   // "<...>"，未闭合时到下一个 '<' 或文本末尾；标签外单独出现的 '>' 也作为一个 Tag
+        Text,
+        Flag,  // 连续的 FLAG 字符
+    };
+
+    struct Token {
+        TokenType type;
+        std::string_view text;
+        size_t offset;  // 在原文中的字节偏移
+    };
+
+    // 富文本的单遍分词器，直接在 UTF-8 上扫描，产出的片段都指向原文，不分配内存
+    class TextTokenizer {
+    public:
+        TextTokenizer(std::string_view text, const FlagSet& flags, bool parseTags = true)
+                : text(text), flags(flags), parseTags(parseTags) {}
+
+        bool Next(Token* token) {
+            if (pos >= text.size()) return false;
+            const size_t start = pos;
+            if (parseTags && (text[pos] == '<' || text[pos] == '>')) {
+                if (text[pos] == '<') {
+                    const auto close = text.find_first_of("<>", pos + 1);
+                    if (close == std::string_view::npos) {
+                        pos = text.size();
+                    }
+                    else {
+                        pos = text[close] == '>' ? close + 1 : close;
+                    }
+                }
+                else {
+                    pos++;
+                }
+                *token = {TokenType::Tag, text.substr(start, pos - start), start};
+                return true;
+            }
+            if (flags.CharLength(text, pos) != 0) {
+                while (pos < text.size()) {
+                    const auto length = flags.CharLength(text, pos);
+                    if (length == 0) break;
+                    pos += length;
+                }
+                *token = {TokenType::Flag, text.substr(start, pos - start), start};
+                return true;
+            }
+            pos++;
+            while (pos < text.size()) {
+                const auto cls = flags.ByteClass(text[pos]);
+                if (cls != 0) {
+                    if (cls & FlagSet::kTagChar) {
+                        if (parseTags) break;
+                    }
+                    else if (flags.CharLength(text, pos) != 0) {
+                        break;
+                    }
+                }
+                pos++;
+            }
+            *token = {TokenType::Text, text.substr(start, pos - start), start};
+            return true;
+        }
+
+        // 从 position 处重新开始分词
+        void Seek(size_t position) {
+            pos = position;
+        }
+
+    private:
+        std::string_view text;
+        const FlagSet& flags;
+        bool parseTags;
+        size_t pos = 0;
+    };
+}
@@ -0,0 +1,153 @@
+/**
+ * @file bench_tokenizer.cpp
+ * @brief Host benchmark: TextTokenizer vs the previous per-call-site tag scanners
+ *
+ * Runs each scanner over every key of a generic.json (or a built-in sample set
+ * when no file is given) and prints ns per string for:
+ * - SplitByTags: std::regex("<.*?>(.*?)</.*?>") vs Tag tokens
+ * - split runs: UTF-16 copy + unordered_set<char16_t> walk vs kSplitFlags tokens
+ * - fmt items: UTF-16 copy + unordered_set<char16_t> walk vs kFmtFlags tokens
+ *
+ * Build (host):
+ *   g++ -std=c++2b -O2 -I.. -I../../deps bench_tokenizer.cpp -o bench_tokenizer
+ *   ./bench_tokenizer [path/to/local-files/genericTrans/generic.json]
+ */
+
+#include "TextTokenizer.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <codecvt>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace StringParser;
+
+namespace {
+    std::u16string ToUTF16(const std::string& str) {
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+        return conv.from_bytes(str);
+    }
+
+    std::string ToUTF8(const std::u16string& str) {
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+        return conv.to_bytes(str);
+    }
+
+    // 旧实现：Local::SplitByTags
+    size_t RegexSplitByTags(const std::string& origText) {
+        static const std::regex tagsRe("<.*?>(.*?)</.*?>");
+        std::string text = origText;
+        std::smatch match;
+        size_t count = 0;
+        while (std::regex_search(text, match, tagsRe)) {
+            count += match[1].length();
+            text = match.suffix().str();
+        }
+        return count;
+    }
+
+    // 旧实现：GetSplitTagsTranslationFull / ParseItems::parse 中的 UTF-16 逐字符扫描
+    size_t SetWalkRuns(const std::string& str, const std::unordered_set<char16_t>& flags) {
+        const auto text = ToUTF16(str);
+        std::vector<std::string> runs;
+        std::u16string current;
+        bool isInTag = false;
+        for (const char16_t c : text) {
+            if (c == u'<') isInTag = true;
+            if (c == u'>' || isInTag || flags.contains(c)) {
+                if (c == u'>') isInTag = false;
+                if (!current.empty()) {
+                    runs.push_back(ToUTF8(current));
+                    current.clear();
+                }
+                continue;
+            }
+            current.push_back(c);
+        }
+        if (!current.empty()) runs.push_back(ToUTF8(current));
+        return runs.size();
+    }
+
+    size_t TokenizerRuns(std::string_view str, const FlagSet& flags) {
+        size_t count = 0;
+        TextTokenizer tokenizer(str, flags);
+        for (Token token; tokenizer.Next(&token);) {
+            if (token.type == TokenType::Text) count++;
+        }
+        return count;
+    }
+
+    size_t TokenizerTags(std::string_view str) {
+        size_t count = 0;
+        TextTokenizer tokenizer(str, kSplitFlags);
+        for (Token token; tokenizer.Next(&token);) {
+            if (token.type == TokenType::Tag) count += token.text.size();
+        }
+        return count;
+    }
+
+    template <typename Fn>
+    double MeasureNs(const std::vector<std::string>& samples, size_t rounds, Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; r++) {
+            for (const auto& sample : samples) {
+                fn(sample);
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(rounds * samples.size());
+    }
+
+    volatile size_t sink = 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> samples;
+    if (argc > 1) {
+        std::ifstream file(argv[1]);
+        const auto data = nlohmann::json::parse(file);
+        for (const auto& [key, value] : data.items()) {
+            samples.push_back(key);
+        }
+    }
+    else {
+        samples = {
+                "ライブスキルを獲得しました",
+                "<color=#FF5A8C>残り12日と3時間</color>",
+                "スキルの効果量が<color=#FF5A8C>+15%</color>アップ（<color=#FF5A8C>3</color>ターン）",
+                "【ハート】獲得量<size=24>＋50％</size>、ボルテージ<color=#FFA0C8>+2</color>",
+                "Live Start",
+        };
+    }
+    if (samples.empty()) {
+        std::printf("no samples\n");
+        return 1;
+    }
+
+    static const std::unordered_set<char16_t> splitFlags = {u'0', u'1', u'2', u'3', u'4', u'5', u'6', u'7', u'8', u'9', u'+', u'＋',
+                                                            u'-', u'－', u'%', u'％', u'【', u'】', u'.', u':', u'：', u'×'};
+    static const std::unordered_set<char16_t> fmtFlags = {u'0', u'1', u'2', u'3', u'4', u'5', u'6', u'7', u'8', u'9', u'+', u'＋',
+                                                          u'-', u'－', u'%', u'％', u'.', u'×', u',', u'，'};
+
+    const size_t rounds = std::max<size_t>(1, 200000 / samples.size());
+    std::printf("%zu strings x %zu rounds\n", samples.size(), rounds);
+    std::printf("%-12s %12s %12s %8s\n", "scanner", "old", "tokenizer", "speedup");
+
+    const double regexNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + RegexSplitByTags(s); });
+    const double tagNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + TokenizerTags(s); });
+    std::printf("%-12s %9.1f ns %9.1f ns %7.1fx\n", "tags", regexNs, tagNs, regexNs / tagNs);
+
+    const double splitOldNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + SetWalkRuns(s, splitFlags); });
+    const double splitNewNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + TokenizerRuns(s, kSplitFlags); });
+    std::printf("%-12s %9.1f ns %9.1f ns %7.1fx\n", "split-runs", splitOldNs, splitNewNs, splitOldNs / splitNewNs);
+
+    const double fmtOldNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + SetWalkRuns(s, fmtFlags); });
+    const double fmtNewNs = MeasureNs(samples, rounds, [](const std::string& s) { sink = sink + TokenizerRuns(s, kFmtFlags); });
+    std::printf("%-12s %9.1f ns %9.1f ns %7.1fx\n", "fmt-items", fmtOldNs, fmtNewNs, fmtOldNs / fmtNewNs);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "Utf.hpp"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define LINKURA_UTF_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define LINKURA_UTF_SSE2 1
+#endif
+
+namespace LinkuraLocal::Utf {
+    namespace {
+        inline bool IsContinuation(unsigned char c) {
+            return (c & 0xC0) == 0x80;
+        }
+
+        // 解码一个码点，返回消耗的字节数，非法时返回 0
+        inline size_t DecodeUtf8(const unsigned char* in, size_t remaining, char16_t*& out) {
+            const unsigned char c0 = in[0];
+            if (c0 < 0x80) {
+                *out++ = c0;
+                return 1;
+            }
+            if (c0 < 0xC2) return 0;
+            if (c0 < 0xE0) {
+                if (remaining < 2 || !IsContinuation(in[1])) return 0;
+                *out++ = static_cast<char16_t>(((c0 & 0x1F) << 6) | (in[1] & 0x3F));
+                return 2;
+            }
+            if (c0 < 0xF0) {
+                if (remaining < 3) return 0;
+                const unsigned char c1 = in[1];
+                if (c0 == 0xE0 ? (c1 < 0xA0 || c1 > 0xBF) :
+                    c0 == 0xED ? (c1 < 0x80 || c1 > 0x9F) : !IsContinuation(c1)) {
+                    return 0;
+                }
+                if (!IsContinuation(in[2])) return 0;
+                *out++ = static_cast<char16_t>(((c0 & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (in[2] & 0x3F));
+                return 3;
+            }
+            if (c0 < 0xF5) {
+                if (remaining < 4) return 0;
+                const unsigned char c1 = in[1];
+                if (c0 == 0xF0 ? (c1 < 0x90 || c1 > 0xBF) :
+                    c0 == 0xF4 ? (c1 < 0x80 || c1 > 0x8F) : !IsContinuation(c1)) {
+                    return 0;
+                }
+                if (!IsContinuation(in[2]) || !IsContinuation(in[3])) return 0;
+                const uint32_t cp = ((c0 & 0x07) << 18) | ((c1 & 0x3F) << 12) | ((in[2] & 0x3F) << 6) | (in[3] & 0x3F);
+                *out++ = static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+                *out++ = static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+                return 4;
+            }
+            return 0;
+        }
+
+        // 编码一个码点，返回消耗的 UTF-16 单元数，非法时返回 0
+        inline size_t EncodeUtf8(const char16_t* in, size_t remaining, char*& out) {
+            const uint32_t u0 = in[0];
+            if (u0 < 0x80) {
+                *out++ = static_cast<char>(u0);
+                return 1;
+            }
+            if (u0 < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (u0 >> 6));
+                *out++ = static_cast<char>(0x80 | (u0 & 0x3F));
+                return 1;
+            }
+            if (u0 < 0xD800 || u0 > 0xDFFF) {
+                *out++ = static_cast<char>(0xE0 | (u0 >> 12));
+                *out++ = static_cast<char>(0x80 | ((u0 >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (u0 & 0x3F));
+                return 1;
+            }
+            if (u0 > 0xDBFF || remaining < 2) return 0;
+            const uint32_t u1 = in[1];
+            if (u1 < 0xDC00 || u1 > 0xDFFF) return 0;
+            const uint32_t cp = 0x10000 + ((u0 - 0xD800) << 10) + (u1 - 0xDC00);
+            *out++ = static_cast<char>(0xF0 | (cp >> 18));
+            *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+            return 2;
+        }
+    }
+
+    size_t Utf8ToUtf16(const char* input, size_t length, char16_t* output) {
+        const auto* in = reinterpret_cast<const unsigned char*>(input);
+        const auto* const end = in + length;
+        char16_t* out = output;
+
+        while (in < end) {
+#if defined(LINKURA_UTF_NEON)
+            if (end - in >= 16) {
+                const uint8x16_t v = vld1q_u8(in);
+                if (vmaxvq_u8(v) < 0x80) {
+                    vst1q_u16(reinterpret_cast<uint16_t*>(out), vmovl_u8(vget_low_u8(v)));
+                    vst1q_u16(reinterpret_cast<uint16_t*>(out + 8), vmovl_high_u8(v));
+                    in += 16;
+                    out += 16;
+                    continue;
+                }
+            }
+            // 连续 8 个 3 字节字符：按字节位置解交织后一次算出 8 个码点
+            if (end - in >= 24 && (in[0] & 0xF0) == 0xE0) {
+                const uint8x8x3_t v = vld3_u8(in);
+                const uint8x8_t leadOk = vceq_u8(vand_u8(v.val[0], vdup_n_u8(0xF0)), vdup_n_u8(0xE0));
+                const uint8x8_t c1Ok = vceq_u8(vand_u8(v.val[1], vdup_n_u8(0xC0)), vdup_n_u8(0x80));
+                const uint8x8_t c2Ok = vceq_u8(vand_u8(v.val[2], vdup_n_u8(0xC0)), vdup_n_u8(0x80));
+                if (vminv_u8(vand_u8(leadOk, vand_u8(c1Ok, c2Ok))) == 0xFF) {
+                    uint16x8_t cp = vshlq_n_u16(vmovl_u8(vand_u8(v.val[0], vdup_n_u8(0x0F))), 12);
+                    cp = vorrq_u16(cp, vshlq_n_u16(vmovl_u8(vand_u8(v.val[1], vdup_n_u8(0x3F))), 6));
+                    cp = vorrq_u16(cp, vmovl_u8(vand_u8(v.val[2], vdup_n_u8(0x3F))));
+                    // 过长编码和代理项交给标量路径报错
+                    const uint16x8_t overlong = vcltq_u16(cp, vdupq_n_u16(0x800));
+                    const uint16x8_t surrogate = vceqq_u16(vandq_u16(cp, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800));
+                    if (vmaxvq_u16(vorrq_u16(overlong, surrogate)) == 0) {
+                        vst1q_u16(reinterpret_cast<uint16_t*>(out), cp);
+                        in += 24;
+                        out += 8;
+                        continue;
+                    }
+                }
+            }
+#elif defined(LINKURA_UTF_SSE2)
+            if (end - in >= 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                if (_mm_movemask_epi8(v) == 0) {
+                    const __m128i zero = _mm_setzero_si128();
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(v, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(v, zero));
+                    in += 16;
+                    out += 16;
+                    continue;
+                }
+            }
+#endif
+            const size_t consumed = DecodeUtf8(in, end - in, out);
+            if (consumed == 0) return kInvalid;
+            in += consumed;
+        }
+        return out - output;
+    }
+
+    size_t Utf16ToUtf8(const char16_t* input, size_t length, char* output) {
+        const char16_t* in = input;
+        const char16_t* const end = in + length;
+        char* out = output;
+
+        while (in < end) {
+#if defined(LINKURA_UTF_NEON)
+            if (end - in >= 8) {
+                const uint16x8_t v = vld1q_u16(reinterpret_cast<const uint16_t*>(in));
+                if (vmaxvq_u16(v) < 0x80) {
+                    vst1_u8(reinterpret_cast<uint8_t*>(out), vmovn_u16(v));
+                    in += 8;
+                    out += 8;
+                    continue;
+                }
+                const uint16x8_t surrogate = vceqq_u16(vandq_u16(v, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800));
+                if (vminvq_u16(v) >= 0x800 && vmaxvq_u16(surrogate) == 0) {
+                    uint8x8x3_t bytes;
+                    bytes.val[0] = vorr_u8(vmovn_u16(vshrq_n_u16(v, 12)), vdup_n_u8(0xE0));
+                    bytes.val[1] = vorr_u8(vand_u8(vmovn_u16(vshrq_n_u16(v, 6)), vdup_n_u8(0x3F)), vdup_n_u8(0x80));
+                    bytes.val[2] = vorr_u8(vand_u8(vmovn_u16(v), vdup_n_u8(0x3F)), vdup_n_u8(0x80));
+                    vst3_u8(reinterpret_cast<uint8_t*>(out), bytes);
+                    in += 8;
+                    out += 24;
+                    continue;
+                }
+            }
+#elif defined(LINKURA_UTF_SSE2)
+            if (end - in >= 8) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                const __m128i high = _mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xFF80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF) {
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v, v));
+                    in += 8;
+                    out += 8;
+                    continue;
+                }
+            }
+#endif
+            const size_t consumed = EncodeUtf8(in, end - in, out);
+            if (consumed == 0) return kInvalid;
+            in += consumed;
+        }
+        return out - output;
+    }
+
+    bool Utf8ToUtf16(std::string_view input, std::u16string* output) {
+        bool ok = true;
+        output->resize_and_overwrite(Utf16BufferSize(input.size()), [&](char16_t* buffer, size_t) {
+            const size_t written = Utf8ToUtf16(input.data(), input.size(), buffer);
+            ok = written != kInvalid;
+            return ok ? written : 0;
+        });
+        return ok;
+    }
+
+    bool Utf16ToUtf8(std::u16string_view input, std::string* output) {
+        bool ok = true;
+        output->resize_and_overwrite(Utf8BufferSize(input.size()), [&](char* buffer, size_t) {
+            const size_t written = Utf16ToUtf8(input.data(), input.size(), buffer);
+            ok = written != kInvalid;
+            return ok ? written : 0;
+        });
+        return ok;
+    }
+
+    bool Utf8EqualsUtf16(std::string_view utf8, std::u16string_view utf16) {
+        // 每个 UTF-16 单元至少对应一个 UTF-8 字节
+        if (utf16.size() > utf8.size()) return false;
+        const auto* in = reinterpret_cast<const unsigned char*>(utf8.data());
+        const auto* const end = in + utf8.size();
+        const char16_t* other = utf16.data();
+        const char16_t* const otherEnd = other + utf16.size();
+
+        while (in < end) {
+            if (*in < 0x80) {
+                if (other == otherEnd || *other != *in) return false;
+                in++;
+                other++;
+                continue;
+            }
+            char16_t decoded[2];
+            char16_t* out = decoded;
+            const size_t consumed = DecodeUtf8(in, end - in, out);
+            if (consumed == 0) return false;
+            const size_t units = out - decoded;
+            if (static_cast<size_t>(otherEnd - other) < units) return false;
+            if (other[0] != decoded[0] || (units == 2 && other[1] != decoded[1])) return false;
+            in += consumed;
+            other += units;
+        }
+        return other == otherEnd;
+    }
+}
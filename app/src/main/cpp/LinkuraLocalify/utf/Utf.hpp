@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace LinkuraLocal::Utf {
+    // UTF-8 <-> UTF-16 转换。ASCII 和 3 字节字符（日文、中文）连续出现时走 NEON / SSE2 向量路径，
+    // 其余情况逐个码点处理。校验规则与 std::codecvt_utf8_utf16 一致：
+    // 拒绝过长编码、UTF-8 中的代理项、超出 U+10FFFF 的码点、截断的序列以及孤立的 UTF-16 代理项。
+
+    constexpr size_t kInvalid = SIZE_MAX;
+
+    // 输出缓冲区所需的最大长度
+    constexpr size_t Utf16BufferSize(size_t utf8Length) { return utf8Length; }
+    constexpr size_t Utf8BufferSize(size_t utf16Length) { return utf16Length * 3; }
+
+    // 写入调用方提供的缓冲区，返回写入的单元数，输入非法时返回 kInvalid
+    size_t Utf8ToUtf16(const char* input, size_t length, char16_t* output);
+    size_t Utf16ToUtf8(const char16_t* input, size_t length, char* output);
+
+    // 复用 output 已有的容量，输入非法时返回 false
+    bool Utf8ToUtf16(std::string_view input, std::u16string* output);
+    bool Utf16ToUtf8(std::u16string_view input, std::string* output);
+
+    // 比较 UTF-8 与 UTF-16 文本是否表示同一字符串，不分配内存
+    bool Utf8EqualsUtf16(std::string_view utf8, std::u16string_view utf16);
+}
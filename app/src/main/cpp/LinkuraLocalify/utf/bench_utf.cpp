@@ -0,0 +1,90 @@
+/**
+ * @file bench_utf.cpp
+ * @brief Host benchmark: Utf transcoder vs std::wstring_convert
+ *
+ * Converts typical UI strings (short ASCII, Japanese, mixed rich text and a
+ * long paragraph) in both directions and prints ns per call for:
+ * - wstring_convert constructed per call (the old Misc::ToUTF16 / ToUTF8)
+ * - Utf::Utf8ToUtf16 / Utf16ToUtf8 writing into a reused buffer
+ *
+ * Build (host):
+ *   g++ -std=c++2b -O2 -I.. bench_utf.cpp Utf.cpp -o bench_utf && ./bench_utf
+ */
+
+#include "Utf.hpp"
+#include <chrono>
+#include <codecvt>
+#include <cstdio>
+#include <locale>
+#include <string>
+#include <vector>
+
+using namespace LinkuraLocal;
+
+namespace {
+    struct Sample {
+        const char* name;
+        std::string text;
+    };
+
+    template <typename Fn>
+    double MeasureNs(size_t iterations, Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            fn();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+    }
+
+    // 防止结果被优化掉
+    volatile size_t sink = 0;
+}
+
+int main() {
+    std::string paragraph;
+    for (int i = 0; i < 20; i++) {
+        paragraph += "ライブで獲得できるスキルポイントが増加します。";
+    }
+    const std::vector<Sample> samples = {
+            {"ascii-short", "Live Start"},
+            {"ascii-long", "The quick brown fox jumps over the lazy dog. 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ"},
+            {"japanese", "ライブスキルを獲得しました"},
+            {"rich-text", "<color=#FF5A8C>残り12日と3時間</color> <size=24>+50％</size>"},
+            {"paragraph", paragraph},
+    };
+
+    constexpr size_t iterations = 200000;
+    std::printf("%-12s %8s %14s %14s %8s\n", "sample", "bytes", "wstring_conv", "Utf", "speedup");
+
+    for (const auto& sample : samples) {
+        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> refConv;
+        const std::u16string utf16 = refConv.from_bytes(sample.text);
+
+        const double refTo16 = MeasureNs(iterations, [&] {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            sink = sink + conv.from_bytes(sample.text.data(), sample.text.data() + sample.text.size()).size();
+        });
+        std::u16string buffer16;
+        const double utfTo16 = MeasureNs(iterations, [&] {
+            Utf::Utf8ToUtf16(sample.text, &buffer16);
+            sink = sink + buffer16.size();
+        });
+
+        const double refTo8 = MeasureNs(iterations, [&] {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            sink = sink + conv.to_bytes(utf16.data(), utf16.data() + utf16.size()).size();
+        });
+        std::string buffer8;
+        const double utfTo8 = MeasureNs(iterations, [&] {
+            Utf::Utf16ToUtf8(utf16, &buffer8);
+            sink = sink + buffer8.size();
+        });
+
+        std::printf("%-12s %8zu %11.1f ns %11.1f ns %7.1fx  (utf8->utf16)\n",
+                    sample.name, sample.text.size(), refTo16, utfTo16, refTo16 / utfTo16);
+        std::printf("%-12s %8zu %11.1f ns %11.1f ns %7.1fx  (utf16->utf8)\n",
+                    sample.name, sample.text.size(), refTo8, utfTo8, refTo8 / utfTo8);
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file test_utf.cpp
+ * @brief Equivalence / fuzz test for the UTF-8 <-> UTF-16 transcoder
+ *
+ * Compares Utf::Utf8ToUtf16 / Utf::Utf16ToUtf8 / Utf::Utf8EqualsUtf16 against the previous
+ * std::wstring_convert based implementation on:
+ * - Hand-written edge cases (overlong forms, surrogates, truncated sequences)
+ * - Random valid text mixing ASCII, 2/3/4-byte characters
+ * - Random byte / code unit noise and mutated valid text
+ *
+ * Well-formed input must produce output identical to std::wstring_convert.
+ * Ill-formed input (per the Unicode well-formedness rules) must be rejected;
+ * this side is checked against an independent validator because libstdc++'s
+ * codecvt accepts some ill-formed input that libc++ (used on Android) rejects.
+ *
+ * Build (host):
+ *   g++ -std=c++2b -O2 -I.. test_utf.cpp Utf.cpp -o test_utf && ./test_utf
+ */
+
+#include "Utf.hpp"
+#include <codecvt>
+#include <iostream>
+#include <locale>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace LinkuraLocal;
+
+namespace {
+    int totalTests = 0;
+    int failedTests = 0;
+
+    std::optional<std::u16string> ReferenceToUtf16(const std::string& str) {
+        try {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return conv.from_bytes(str.data(), str.data() + str.size());
+        }
+        catch (const std::range_error&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<std::string> ReferenceToUtf8(const std::u16string& str) {
+        try {
+            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+            return conv.to_bytes(str.data(), str.data() + str.size());
+        }
+        catch (const std::range_error&) {
+            return std::nullopt;
+        }
+    }
+
+    // Unicode 表 3-7
+    bool IsWellFormedUtf8(const std::string& str) {
+        const auto* p = reinterpret_cast<const unsigned char*>(str.data());
+        const auto* end = p + str.size();
+        while (p < end) {
+            const unsigned char c = *p;
+            size_t n;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (c < 0x80) n = 1;
+            else if (c >= 0xC2 && c <= 0xDF) n = 2;
+            else if (c == 0xE0) { n = 3; lo = 0xA0; }
+            else if (c >= 0xE1 && c <= 0xEC) n = 3;
+            else if (c == 0xED) { n = 3; hi = 0x9F; }
+            else if (c >= 0xEE && c <= 0xEF) n = 3;
+            else if (c == 0xF0) { n = 4; lo = 0x90; }
+            else if (c >= 0xF1 && c <= 0xF3) n = 4;
+            else if (c == 0xF4) { n = 4; hi = 0x8F; }
+            else return false;
+            if (static_cast<size_t>(end - p) < n) return false;
+            if (n > 1 && (p[1] < lo || p[1] > hi)) return false;
+            for (size_t i = 2; i < n; i++) {
+                if (p[i] < 0x80 || p[i] > 0xBF) return false;
+            }
+            p += n;
+        }
+        return true;
+    }
+
+    bool IsWellFormedUtf16(const std::u16string& str) {
+        for (size_t i = 0; i < str.size(); i++) {
+            if (str[i] >= 0xD800 && str[i] <= 0xDBFF) {
+                if (i + 1 >= str.size() || str[i + 1] < 0xDC00 || str[i + 1] > 0xDFFF) return false;
+                i++;
+            }
+            else if (str[i] >= 0xDC00 && str[i] <= 0xDFFF) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string Hex(const std::string& str) {
+        static const char digits[] = "0123456789abcdef";
+        std::string ret;
+        for (unsigned char c : str) {
+            ret += digits[c >> 4];
+            ret += digits[c & 15];
+            ret += ' ';
+        }
+        return ret;
+    }
+
+    std::string Hex(const std::u16string& str) {
+        std::string bytes;
+        for (char16_t c : str) {
+            bytes += static_cast<char>(c >> 8);
+            bytes += static_cast<char>(c & 0xFF);
+        }
+        return Hex(bytes);
+    }
+
+    void Report(bool passed, const std::string& name) {
+        totalTests++;
+        if (!passed) {
+            failedTests++;
+            std::cout << "[FAIL] " << name << std::endl;
+        }
+    }
+
+    void CheckUtf8(const std::string& input, const std::string& name) {
+        const auto expected = IsWellFormedUtf8(input) ? ReferenceToUtf16(input) : std::nullopt;
+        std::u16string actual;
+        const bool ok = Utf::Utf8ToUtf16(input, &actual);
+        Report(ok == expected.has_value() && (!ok || actual == *expected),
+               name + " utf8->utf16 input: " + Hex(input));
+
+        // 非零偏移，覆盖未对齐的向量读写
+        std::vector<char16_t> buffer(Utf::Utf16BufferSize(input.size()) + 1);
+        const size_t written = Utf::Utf8ToUtf16(input.data(), input.size(), buffer.data() + 1);
+        Report((written == Utf::kInvalid) == !expected.has_value() &&
+               (written == Utf::kInvalid || std::u16string(buffer.data() + 1, written) == *expected),
+               name + " utf8->utf16 (buffer) input: " + Hex(input));
+    }
+
+    void CheckEquals(const std::string& utf8, const std::u16string& utf16, const std::string& name) {
+        const auto converted = IsWellFormedUtf8(utf8) ? ReferenceToUtf16(utf8) : std::nullopt;
+        const bool expected = converted.has_value() && *converted == utf16;
+        Report(Utf::Utf8EqualsUtf16(utf8, utf16) == expected, name + " equals input: " + Hex(utf8) + "/ " + Hex(utf16));
+    }
+
+    void CheckUtf16(const std::u16string& input, const std::string& name) {
+        const auto expected = IsWellFormedUtf16(input) ? ReferenceToUtf8(input) : std::nullopt;
+        std::string actual;
+        const bool ok = Utf::Utf16ToUtf8(input, &actual);
+        Report(ok == expected.has_value() && (!ok || actual == *expected),
+               name + " utf16->utf8 input: " + Hex(input));
+
+        std::vector<char> buffer(Utf::Utf8BufferSize(input.size()) + 1);
+        const size_t written = Utf::Utf16ToUtf8(input.data(), input.size(), buffer.data() + 1);
+        Report((written == Utf::kInvalid) == !expected.has_value() &&
+               (written == Utf::kInvalid || std::string(buffer.data() + 1, written) == *expected),
+               name + " utf16->utf8 (buffer) input: " + Hex(input));
+    }
+
+    void TestEdgeCases() {
+        const std::vector<std::string> utf8Cases = {
+                "",
+                "a",
+                "0123456789abcdef",
+                "0123456789abcdefX",
+                "残り12日と3時間",
+                "ライブスキルを獲得しました。ライブスキルを獲得しました。",
+                "<color=#ff0000>+50％</color>×2",
+                "\xC2\x80", "\xDF\xBF",                         // 2 字节边界
+                "\xE0\xA0\x80", "\xEF\xBF\xBF",                 // 3 字节边界
+                "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",         // 4 字节边界
+                "\xEF\xBB\xBF" "bom",                           // BOM 原样保留
+                "\xC0\x80", "\xC1\xBF",                         // 过长编码
+                "\xE0\x80\x80", "\xE0\x9F\xBF",
+                "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+                "\xED\xA0\x80", "\xED\xBF\xBF",                 // 代理项
+                "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",         // 超出 U+10FFFF
+                "\x80", "\xBF", "\xFE", "\xFF",                 // 孤立的后续字节、非法字节
+                "\xE3\x81", "\xF0\x9F\x98",                     // 截断
+                "あいうえおかきくけこさしすせそ\xE3\x81",
+                "あいうえおかきく\xED\xA0\x80けこさしすせそたちつてと",
+                "あいうえおかきく\xE0\x80\x80けこさしすせそたちつてと",
+                "あいうえおかきくけこさしすせそabcdefghijklmnop😀",
+        };
+        for (size_t i = 0; i < utf8Cases.size(); i++) {
+            CheckUtf8(utf8Cases[i], "edge case " + std::to_string(i));
+        }
+
+        const std::vector<std::u16string> utf16Cases = {
+                u"",
+                u"abcdefgh",
+                u"abcdefghi",
+                u"残り12日と3時間",
+                u"ライブスキルを獲得しました",
+                std::u16string(1, char16_t(0xD800)),
+                std::u16string(1, char16_t(0xDC00)),
+                std::u16string{char16_t(0xD800), u'a'},
+                std::u16string{char16_t(0xDBFF), char16_t(0xDFFF)},
+                u"あいうえおかきく" + std::u16string(1, char16_t(0xDC00)),
+                u"あいうえおかき" + std::u16string(1, char16_t(0xD83D)),
+                std::u16string{char16_t(0xFFFF), char16_t(0xE000), char16_t(0xD7FF), char16_t(0x800),
+                               char16_t(0x7FF), char16_t(0x80), char16_t(0x7F), char16_t(0)},
+        };
+        for (size_t i = 0; i < utf16Cases.size(); i++) {
+            CheckUtf16(utf16Cases[i], "edge case " + std::to_string(i));
+        }
+    }
+
+    char32_t RandomCodePoint(std::mt19937& rng) {
+        switch (rng() % 6) {
+            case 0:
+            case 1:
+                return rng() % 0x80;
+            case 2:
+                return 0x80 + rng() % (0x800 - 0x80);
+            case 3:
+                return 0x3040 + rng() % (0x9FFF - 0x3040);  // 假名、汉字
+            case 4: {
+                char32_t cp = 0x800 + rng() % (0x10000 - 0x800);
+                return (cp >= 0xD800 && cp <= 0xDFFF) ? cp - 0x800 : cp;
+            }
+            default:
+                return 0x10000 + rng() % (0x110000 - 0x10000);
+        }
+    }
+
+    std::u16string RandomValidUtf16(std::mt19937& rng, size_t codePoints) {
+        std::u16string ret;
+        for (size_t i = 0; i < codePoints; i++) {
+            const char32_t cp = RandomCodePoint(rng);
+            if (cp < 0x10000) {
+                ret += static_cast<char16_t>(cp);
+            }
+            else {
+                ret += static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+                ret += static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+            }
+        }
+        return ret;
+    }
+
+    // 只含某一类字符的长文本，覆盖向量路径
+    std::u16string RandomRun(std::mt19937& rng, size_t length, char16_t base, char16_t range) {
+        std::u16string ret;
+        for (size_t i = 0; i < length; i++) {
+            ret += static_cast<char16_t>(base + rng() % range);
+        }
+        return ret;
+    }
+
+    void TestRandom() {
+        std::mt19937 rng(20240601);
+        for (int i = 0; i < 20000; i++) {
+            std::u16string utf16;
+            switch (i % 4) {
+                case 0:
+                    utf16 = RandomValidUtf16(rng, rng() % 64);
+                    break;
+                case 1:
+                    utf16 = RandomRun(rng, rng() % 80, 0x20, 0x5F) + RandomValidUtf16(rng, rng() % 4);
+                    break;
+                case 2:
+                    utf16 = RandomRun(rng, rng() % 80, 0x3040, 0x60) + RandomRun(rng, rng() % 20, 0x30, 10) +
+                            RandomRun(rng, rng() % 40, 0x4E00, 0x5000);
+                    break;
+                default:
+                    utf16 = RandomValidUtf16(rng, rng() % 8) + RandomRun(rng, rng() % 40, 0xE000, 0x1FFF);
+                    break;
+            }
+            CheckUtf16(utf16, "random valid #" + std::to_string(i));
+            const auto utf8 = ReferenceToUtf8(utf16);
+            if (!utf8) {
+                Report(false, "reference failed on valid input #" + std::to_string(i));
+                continue;
+            }
+            CheckUtf8(*utf8, "random valid #" + std::to_string(i));
+            CheckEquals(*utf8, utf16, "random valid #" + std::to_string(i));
+
+            // 随机改写若干字节 / 单元
+            std::string mutated8 = *utf8;
+            std::u16string mutated16 = utf16;
+            for (int n = 0; n < 3 && !mutated8.empty(); n++) {
+                mutated8[rng() % mutated8.size()] = static_cast<char>(rng());
+                mutated16[rng() % mutated16.size()] = static_cast<char16_t>(rng() % 2 ? 0xD800 + rng() % 0x800 : rng());
+            }
+            CheckUtf8(mutated8, "random mutated #" + std::to_string(i));
+            CheckUtf16(mutated16, "random mutated #" + std::to_string(i));
+            CheckEquals(mutated8, utf16, "random mutated #" + std::to_string(i));
+            CheckEquals(*utf8, mutated16, "random mutated #" + std::to_string(i));
+        }
+
+        for (int i = 0; i < 20000; i++) {
+            std::string noise(rng() % 48, '\0');
+            for (auto& c : noise) c = static_cast<char>(rng());
+            CheckUtf8(noise, "random noise #" + std::to_string(i));
+
+            std::u16string noise16(rng() % 24, u'\0');
+            for (auto& c : noise16) c = static_cast<char16_t>(rng());
+            CheckUtf16(noise16, "random noise #" + std::to_string(i));
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== UTF Transcoder Equivalence Test ===" << std::endl;
+    TestEdgeCases();
+    TestRandom();
+    std::cout << "Total: " << totalTests << ", Failed: " << failedTests << std::endl;
+    return failedTests == 0 ? 0 : 1;
+}
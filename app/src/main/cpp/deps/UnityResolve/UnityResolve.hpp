@@ -1464,7 +1464,7 @@ public:
 					// using convert_typeX = std::codecvt_utf8<wchar_t>;
 					// std::wstring_convert<convert_typeX> converterX;
 					// return converterX.to_bytes(m_firstChar);
-                    return LinkuraLocal::Misc::ToUTF8(chars);
+                    return LinkuraLocal::Misc::ToUTF8(std::u16string_view(chars, length));
 				}
 				catch (std::exception& e) {
 					std::cout << "String Invoke Error\n";